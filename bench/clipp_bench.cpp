@@ -0,0 +1,479 @@
+/*****************************************************************************
+ *
+ * CLIPP - command line interfaces for modern C++
+ *
+ * released under MIT license
+ *
+ * (c) 2017-2018 André Müller; foss@andremueller-online.de
+ *
+ * Benchmark: parses synthetic argument lists of growing size with
+ *            command line interfaces of different shapes and reports
+ *            time, heap allocations and peak heap usage per argument
+ *
+ *****************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <clipp.h>
+
+
+/*************************************************************************//**
+ *
+ * @brief heap allocation tracking (replaces global operator new/delete)
+ *
+ *****************************************************************************/
+namespace {
+
+struct heap_stats {
+    std::size_t allocs = 0;
+    std::size_t live = 0;
+    std::size_t peak = 0;
+};
+
+heap_stats heap;
+
+//allocation header: keeps size for bookkeeping in operator delete
+constexpr std::size_t header_size = sizeof(std::max_align_t);
+
+} // namespace
+
+
+void* operator new(std::size_t n)
+{
+    auto p = static_cast<char*>(std::malloc(n + header_size));
+    if(!p) throw std::bad_alloc{};
+    *reinterpret_cast<std::size_t*>(p) = n;
+    ++heap.allocs;
+    heap.live += n;
+    heap.peak = std::max(heap.peak, heap.live);
+    return p + header_size;
+}
+
+void operator delete(void* ptr) noexcept
+{
+    if(!ptr) return;
+    auto p = static_cast<char*>(ptr) - header_size;
+    heap.live -= *reinterpret_cast<std::size_t*>(p);
+    std::free(p);
+}
+
+void* operator new[](std::size_t n) { return ::operator new(n); }
+void operator delete[](void* ptr) noexcept { ::operator delete(ptr); }
+
+#if __cplusplus >= 201402L
+void operator delete(void* ptr, std::size_t) noexcept { ::operator delete(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { ::operator delete(ptr); }
+#endif
+
+
+
+/*************************************************************************//**
+ *
+ * @brief synthetic command line interface together with a generator
+ *        for argument lists of arbitrary length
+ *
+ *****************************************************************************/
+struct targets {
+    std::vector<std::string> strings;
+    std::vector<int> ints;
+    std::string str;
+    int num = 0;
+    bool flag = false;
+
+    void clear() {
+        strings.clear();
+        ints.clear();
+        str.clear();
+        num = 0;
+        flag = false;
+    }
+};
+
+using rng_t = std::mt19937;
+
+struct benchmark {
+    std::string name;
+    std::string info;
+    clipp::group cli;
+    std::function<clipp::arg_list(std::size_t,rng_t&)> args;
+};
+
+
+//-------------------------------------------------------------------
+/** @brief many independent, repeatable options, half of them with a value */
+benchmark flat_options(targets& t, int width = 100)
+{
+    using namespace clipp;
+    group cli;
+    for(int i = 0; i < width; ++i) {
+        const auto flag = "--opt" + std::to_string(i);
+        if(i % 2) {
+            cli.push_back(repeatable(option(flag) & value("v", t.str)));
+        } else {
+            cli.push_back(option(flag).set(t.flag).repeatable(true));
+        }
+    }
+    return benchmark{"flat", std::to_string(width) + " options", cli,
+        [width](std::size_t n, rng_t& rng) {
+            arg_list args;
+            args.reserve(n);
+            while(args.size() < n) {
+                auto i = int(rng() % unsigned(width));
+                //no room for a value => use option without value
+                if(i % 2 && args.size() + 1 == n) --i;
+                args.push_back("--opt" + std::to_string(i));
+                if(i % 2) args.push_back("val");
+            }
+            return args;
+        }};
+}
+
+
+//-------------------------------------------------------------------
+/** @brief repeatable options in nested groups */
+benchmark deep_nesting(targets& t, int depth = 32)
+{
+    using namespace clipp;
+    const auto opt = [&](int i) {
+        return option("-d" + std::to_string(i)).set(t.flag).repeatable(true);
+    };
+    group cli = group{opt(depth-1)};
+    for(int i = depth-2; i >= 0; --i) {
+        cli = group{opt(i), cli};
+    }
+    return benchmark{"deep", std::to_string(depth) + " nesting levels", cli,
+        [depth](std::size_t n, rng_t& rng) {
+            arg_list args;
+            args.reserve(n);
+            for(std::size_t i = 0; i < n; ++i) {
+                args.push_back("-d" + std::to_string(rng() % unsigned(depth)));
+            }
+            return args;
+        }};
+}
+
+
+//-------------------------------------------------------------------
+/** @brief repeatable choice between many options;
+ *         (a repeatable choice of commands would block all but the first
+ *         chosen alternative)
+ */
+benchmark wide_alternatives(targets& t, int width = 256)
+{
+    using namespace clipp;
+    group alts;
+    for(int i = 0; i < width; ++i) {
+        alts.push_back(option("--alt" + std::to_string(i)).set(t.flag));
+    }
+    alts.exclusive(true);
+    auto cli = repeatable(alts);
+    return benchmark{"one_of", std::to_string(width) + " alternatives", cli,
+        [width](std::size_t n, rng_t& rng) {
+            arg_list args;
+            args.reserve(n);
+            for(std::size_t i = 0; i < n; ++i) {
+                args.push_back("--alt" + std::to_string(rng() % unsigned(width)));
+            }
+            return args;
+        }};
+}
+
+
+//-------------------------------------------------------------------
+/** @brief single-letter flags that can be joined like "-xzf" */
+benchmark joinable_flags(targets& t)
+{
+    using namespace clipp;
+    group flags;
+    for(char c = 'a'; c <= 'z'; ++c) {
+        flags.push_back(option(std::string("-") + c).set(t.flag));
+    }
+    auto cli = repeatable(joinable(flags));
+    return benchmark{"joinable", "26 joinable flags", cli,
+        [](std::size_t n, rng_t& rng) {
+            arg_list args;
+            args.reserve(n);
+            for(std::size_t i = 0; i < n; ++i) {
+                std::string a = "-";
+                const auto len = 1 + rng() % 4;
+                for(unsigned j = 0; j < len; ++j) {
+                    a += char('a' + rng() % 26);
+                }
+                args.push_back(std::move(a));
+            }
+            return args;
+        }};
+}
+
+
+//-------------------------------------------------------------------
+/** @brief repeatable group of options with values */
+benchmark repeatable_group(targets& t)
+{
+    using namespace clipp;
+    auto cli = repeatable(
+        option("-i", "--input") & value("file", t.strings),
+        option("-n") & integer("count", t.ints),
+        option("-v").set(t.flag) );
+    return benchmark{"repeatable", "repeatable options with values", cli,
+        [](std::size_t n, rng_t& rng) {
+            arg_list args;
+            args.reserve(n);
+            while(args.size() < n) {
+                //no room for a value => use option without value
+                switch(args.size() + 1 == n ? 2 : rng() % 3) {
+                    default:
+                    case 0: args.push_back("-i"); args.push_back("in.txt"); break;
+                    case 1: args.push_back("-n"); args.push_back("42"); break;
+                    case 2: args.push_back("-v"); break;
+                }
+            }
+            return args;
+        }};
+}
+
+
+//-------------------------------------------------------------------
+/** @brief list of positional values */
+benchmark positional_values(targets& t)
+{
+    using namespace clipp;
+    auto cli = (
+        option("-v").set(t.flag),
+        values("files", t.strings) );
+    return benchmark{"values", "positional values", cli,
+        [](std::size_t n, rng_t&) {
+            arg_list args;
+            args.reserve(n);
+            for(std::size_t i = 0; i < n; ++i) {
+                args.push_back("file" + std::to_string(i) + ".txt");
+            }
+            return args;
+        }};
+}
+
+
+//-------------------------------------------------------------------
+/** @brief interface of example 'naval_fate' */
+benchmark naval_fate(targets& t)
+{
+    using namespace clipp;
+    auto coordinates = ( value("x", t.num), value("y", t.num) );
+
+    auto shipnew  = ( command("new"), values("name", t.strings) );
+    auto shipmove = (
+        value("name", t.strings),
+        command("move"), coordinates,
+        option("--speed=") & value("kn", t.num) );
+    auto shipshoot = ( command("shoot"), coordinates );
+    auto mines = (
+        command("mine"),
+        (command("set") | command("remove")),
+        coordinates,
+        (option("--moored") | option("--drifting")) );
+
+    auto cli = (
+        ( command("ship"), ( shipnew | shipmove | shipshoot ) )
+        | mines
+        | command("-h", "--help")
+        | command("--version") );
+
+    return benchmark{"naval_fate", "ship new <name>...", cli,
+        [](std::size_t n, rng_t&) {
+            arg_list args {"ship", "new"};
+            args.reserve(n);
+            for(std::size_t i = 2; i < n; ++i) {
+                args.push_back("ship" + std::to_string(i));
+            }
+            args.resize(n);
+            return args;
+        }};
+}
+
+
+//-------------------------------------------------------------------
+/** @brief interface of example 'finder' */
+benchmark finder(targets& t)
+{
+    using namespace clipp;
+    auto makeMode = (
+        command("make"),
+        value("wordfile", t.strings),
+        required("-dict") & value("dictionary", t.str),
+        option("--progress", "-p").set(t.flag) );
+
+    auto findMode = (
+        command("find"),
+        values("infile", t.strings),
+        required("-dict") & value("dictionary", t.str),
+        option("-o", "--output") & value("outfile", t.str),
+        ( option("-split").set(t.flag) | option("-nosplit") ) );
+
+    auto cli = (
+        (makeMode | findMode | command("help") ),
+        option("-v", "--version").set(t.flag) );
+
+    return benchmark{"finder", "find <infile>... -dict <dictionary>", cli,
+        [](std::size_t n, rng_t&) {
+            arg_list args {"find"};
+            args.reserve(n);
+            while(args.size() + 2 < n) {
+                args.push_back("in" + std::to_string(args.size()) + ".txt");
+            }
+            args.push_back("-dict");
+            args.push_back("words.dic");
+            args.resize(n);
+            return args;
+        }};
+}
+
+
+
+/*************************************************************************//**
+ *
+ * @brief runs one benchmark for all argument list sizes
+ * @return false, if an argument list could not be parsed successfully
+ *
+ *****************************************************************************/
+struct settings {
+    std::size_t minArgs = 10;
+    std::size_t maxArgs = 1000000;
+    std::size_t minWork = 100000;
+    double budget = 10.0;
+};
+
+
+bool run(benchmark& b, targets& t, const settings& cfg)
+{
+    using clock = std::chrono::steady_clock;
+
+    const auto compiled = clipp::compile(b.cli);
+    rng_t rng {1234};
+
+    for(std::size_t n = cfg.minArgs; n <= cfg.maxArgs; n *= 10) {
+        const auto args = b.args(n, rng);
+        //repeat small runs to get meaningful timings
+        const auto reps = std::max(std::size_t(1), cfg.minWork / n);
+
+        bool valid = true;
+        double seconds = 0;
+        std::size_t allocs = 0;
+        std::size_t peak = 0;
+
+        for(std::size_t r = 0; r < reps; ++r) {
+            t.clear();
+            const auto allocs0 = heap.allocs;
+            const auto live0 = heap.live;
+            heap.peak = heap.live;
+
+            const auto start = clock::now();
+            const auto res = clipp::parse(args, compiled);
+            seconds += std::chrono::duration<double>(clock::now() - start).count();
+
+            allocs += heap.allocs - allocs0;
+            peak = std::max(peak, heap.peak - live0);
+            valid = valid && bool(res);
+        }
+
+        const auto runs = double(reps);
+        const auto perArg = double(n) * runs;
+        std::cout << std::left
+                  << std::setw(12) << b.name
+                  << std::right
+                  << std::setw(9) << n
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(12) << (1e9 * seconds / perArg)
+                  << std::setw(12) << (double(allocs) / perArg)
+                  << std::setw(14) << (double(peak) / 1024.0)
+                  << std::setw(7) << (valid ? "yes" : "no")
+                  << '\n';
+
+        //timings of failing parses don't reflect normal parsing
+        if(!valid) {
+            std::cout << std::left << std::setw(12) << b.name
+                      << " argument list is not valid; aborting\n";
+            return false;
+        }
+
+        if(seconds / runs > cfg.budget) {
+            std::cout << std::left << std::setw(12) << b.name
+                      << " time budget exceeded; skipping larger sizes\n";
+            break;
+        }
+    }
+    return true;
+}
+
+
+
+//-------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+    using namespace clipp;
+
+    settings cfg;
+    std::vector<std::string> selected;
+    bool help = false;
+
+    auto cli = (
+        (option("-n", "--max") & integer("args", cfg.maxArgs))
+            % "maximum argument list size (default: 1000000)",
+        (option("--min") & integer("args", cfg.minArgs))
+            % "minimum argument list size (default: 10)",
+        (option("-w", "--work") & integer("args", cfg.minWork))
+            % "number of arguments to parse at least per measurement; "
+              "small argument lists are parsed repeatedly (default: 100000)",
+        (option("-t", "--budget") & number("seconds", cfg.budget))
+            % "stop scaling up a benchmark after a run took longer "
+              "(default: 10)",
+        option("-h", "--help").set(help)
+            % "show this help",
+        opt_values("benchmark", selected)
+            % "benchmarks to run: flat, deep, one_of, joinable, repeatable, "
+              "values, naval_fate, finder (default: all)"
+    );
+
+    auto res = parse(argc, argv, cli);
+    if(!res || help || cfg.minArgs < 1) {
+        std::cout << make_man_page(cli, argv[0]) << '\n';
+        return res ? 0 : 1;
+    }
+
+    targets t;
+    std::vector<benchmark> benchmarks;
+    benchmarks.push_back(flat_options(t));
+    benchmarks.push_back(deep_nesting(t));
+    benchmarks.push_back(wide_alternatives(t));
+    benchmarks.push_back(joinable_flags(t));
+    benchmarks.push_back(repeatable_group(t));
+    benchmarks.push_back(positional_values(t));
+    benchmarks.push_back(naval_fate(t));
+    benchmarks.push_back(finder(t));
+
+    std::cout << std::left << std::setw(12) << "benchmark" << std::right
+              << std::setw(9) << "args"
+              << std::setw(12) << "ns/arg"
+              << std::setw(12) << "allocs/arg"
+              << std::setw(14) << "peak KiB"
+              << std::setw(7) << "valid" << '\n';
+
+    bool ok = true;
+    for(auto& b : benchmarks) {
+        if(selected.empty() ||
+            std::find(selected.begin(), selected.end(), b.name) != selected.end())
+        {
+            if(!run(b, t, cfg)) ok = false;
+        }
+    }
+    return ok ? 0 : 1;
+}
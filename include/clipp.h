@@ -36,15 +36,41 @@
 #include <cstdlib>
 #include <cstring>
 #include <cctype>
+#include <cerrno>
+#include <cfloat>
+#include <cstddef>
+#include <clocale>
+#include <new>
 #include <memory>
 #include <vector>
+#include <array>
 #include <limits>
+#include <cstdint>
 #include <stack>
 #include <algorithm>
 #include <sstream>
+#include <fstream>
 #include <utility>
 #include <iterator>
 #include <functional>
+#include <unordered_map>
+#include <unordered_set>
+
+//parser state and parsing results allocate from std::pmr memory resources
+//only if CLIPP_ENABLE_PMR is defined; this changes the types of
+//parser & parsing_result members, so it must be defined (or not) for
+//all translation units of a program
+#ifdef CLIPP_ENABLE_PMR
+#  if __cplusplus >= 201703L && defined(__has_include)
+#    if __has_include(<memory_resource>)
+#      include <memory_resource>
+#      define CLIPP_HAS_PMR 1
+#    endif
+#  endif
+#  ifndef CLIPP_HAS_PMR
+#    error "CLIPP_ENABLE_PMR requires C++17 and <memory_resource>"
+#  endif
+#endif
 
 
 /*************************************************************************//**
@@ -289,22 +315,6 @@ struct has_size_getter :
 namespace detail {
 
 
-/*************************************************************************//**
- * @brief forwards string to first non-whitespace char;
- *        std string -> unsigned conv yields max value, but we want 0;
- *        also checks for nullptr
- *****************************************************************************/
-inline bool
-fwd_to_unsigned_int(const char*& s)
-{
-    if(!s) return false;
-    for(; std::isspace(*s); ++s);
-    if(!s[0] || s[0] == '-') return false;
-    if(s[0] == '-') return false;
-    return true;
-}
-
-
 /*************************************************************************//**
  *
  * @brief value limits clamping
@@ -344,123 +354,498 @@ inline T clamped_on_limits(const V& v) {
 
 /*************************************************************************//**
  *
- * @brief type conversion helpers
+ * @brief outcome of a string -> number conversion (like std::from_chars);
+ *        'ptr' points to the first character that is not part of the
+ *        number (if 'ptr' != end of input there is trailing garbage)
+ *
+ *****************************************************************************/
+enum class conversion_status { ok, invalid, out_of_range };
+
+struct conversion_result {
+    const char* ptr;
+    conversion_status status;
+};
+
+
+//-------------------------------------------------------------------
+/** @brief whitespace in the "C" locale */
+inline bool is_space(char c) noexcept {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+inline bool is_digit(char c) noexcept {
+    return c >= '0' && c <= '9';
+}
+
+
+/*************************************************************************//**
+ *
+ * @brief converts [first,last) to an integer of type T with the same rules
+ *        as 'std::strtoll' / 'std::strtoull' with base 10 in the "C"
+ *        locale (leading whitespace and '+' are allowed);
+ *        out of range values are clamped at T's limits,
+ *        negative numbers are invalid for unsigned T and yield 0
  *
  *****************************************************************************/
 template<class T>
-struct make {
-    static inline T from(const char* s) {
-        if(!s) return false;
-        //a conversion from const char* to / must exist
-        return static_cast<T>(s);
+conversion_result
+parse_integer(const char* first, const char* last, T& value) noexcept
+{
+    using ull = unsigned long long int;
+    constexpr ull ullmax = std::numeric_limits<ull>::max();
+
+    auto p = first;
+    while(p != last && is_space(*p)) ++p;
+
+    bool neg = false;
+    if(p != last && (*p == '+' || *p == '-')) {
+        neg = *p == '-';
+        ++p;
+    }
+    if(neg && !std::is_signed<T>::value) {
+        value = T(0);
+        return conversion_result{first, conversion_status::invalid};
     }
-};
 
-template<>
-struct make<bool> {
-    static inline bool from(const char* s) {
-        if(!s) return false;
-        return static_cast<bool>(s);
+    const auto fstDigit = p;
+    ull m = 0;
+    bool overflow = false;
+    for(; p != last && is_digit(*p); ++p) {
+        const auto d = ull(*p - '0');
+        if(m > (ullmax - d) / 10) overflow = true; else m = m * 10 + d;
+    }
+    if(p == fstDigit) {
+        value = T(0);
+        return conversion_result{first, conversion_status::invalid};
     }
-};
 
-template<>
-struct make<unsigned char> {
-    static inline unsigned char from(const char* s) {
-        if(!fwd_to_unsigned_int(s)) return (0);
-        return clamped_on_limits<unsigned char>(std::strtoull(s,nullptr,10));
+    using wide = typename std::conditional<std::is_signed<T>::value,
+                                           long long int, ull>::type;
+    constexpr auto wmax = ull(std::numeric_limits<wide>::max());
+    wide w;
+    if(!neg) {
+        if(m > wmax) overflow = true;
+        w = overflow ? std::numeric_limits<wide>::max() : wide(m);
+    } else {
+        if(m > wmax + 1) overflow = true;
+        w = overflow ? std::numeric_limits<wide>::lowest()
+                     : (m == wmax + 1 ? std::numeric_limits<wide>::lowest()
+                                      : wide(-wide(m)));
     }
-};
 
-template<>
-struct make<unsigned short int> {
-    static inline unsigned short int from(const char* s) {
-        if(!fwd_to_unsigned_int(s)) return (0);
-        return clamped_on_limits<unsigned short int>(std::strtoull(s,nullptr,10));
+    value = clamped_on_limits<T>(w);
+    if(overflow || wide(value) != w) {
+        return conversion_result{p, conversion_status::out_of_range};
     }
-};
+    return conversion_result{p, conversion_status::ok};
+}
+
+
+
+/*************************************************************************//**
+ *
+ * @brief string -> floating point conversion with the C library
+ *        (used for all cases that the fast path doesn't handle);
+ *        the decimal point is always '.' regardless of the C locale
+ *
+ *****************************************************************************/
+inline float  strto_float(const char* s, char** e, float)  { return std::strtof(s,e); }
+inline double strto_float(const char* s, char** e, double) { return std::strtod(s,e); }
+inline long double
+strto_float(const char* s, char** e, long double) { return std::strtold(s,e); }
+
+template<class T>
+conversion_result
+parse_float_slow(const char* first, const char* last, T& value)
+{
+    std::string buf(first, last);
+    const char point = *std::localeconv()->decimal_point;
+    if(point != '.') {
+        for(auto& c : buf) {
+            //the locale's decimal point must end the number
+            if(c == point) { c = ' '; break; }
+            if(c == '.') c = point;
+        }
+    }
+    char* end = nullptr;
+    const auto olderr = errno;
+    errno = 0;
+    value = strto_float(buf.c_str(), &end, T(0));
+    const bool range = errno == ERANGE;
+    errno = olderr;
+
+    if(end == buf.c_str()) {
+        return conversion_result{first, conversion_status::invalid};
+    }
+    return conversion_result{first + (end - buf.c_str()),
+        range ? conversion_status::out_of_range : conversion_status::ok};
+}
+
+
+//-------------------------------------------------------------------
+/** @brief 10^e for exactly representable powers of 10 */
+template<class T>
+inline T exact_pow10(int e) noexcept {
+    static const double p[] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9, 1e10,
+        1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20,
+        1e21, 1e22 };
+    return T(p[e]);
+}
 
 template<>
-struct make<unsigned int> {
-    static inline unsigned int from(const char* s) {
-        if(!fwd_to_unsigned_int(s)) return (0);
-        return clamped_on_limits<unsigned int>(std::strtoull(s,nullptr,10));
+inline long double exact_pow10<long double>(int e) noexcept {
+    static const long double p[] = {
+        1e0L,  1e1L,  1e2L,  1e3L,  1e4L,  1e5L,  1e6L,  1e7L,  1e8L,  1e9L,
+        1e10L, 1e11L, 1e12L, 1e13L, 1e14L, 1e15L, 1e16L, 1e17L, 1e18L,
+        1e19L, 1e20L, 1e21L, 1e22L, 1e23L, 1e24L, 1e25L, 1e26L, 1e27L };
+    return p[e];
+}
+
+/** @brief largest 'e' for which 10^e is exactly representable as a T;
+ *         -1 if arithmetic with T might not round correctly */
+template<class T>
+constexpr int max_exact_pow10() noexcept {
+    return (!std::numeric_limits<T>::is_iec559 || FLT_EVAL_METHOD != 0)
+        ? -1
+        : std::numeric_limits<T>::digits >= 64 ? 27
+        : std::numeric_limits<T>::digits >= 53 ? 22
+        : std::numeric_limits<T>::digits >= 24 ? 10 : -1;
+}
+
+
+/*************************************************************************//**
+ *
+ * @brief converts [first,last) to a floating point value with the same
+ *        results as 'std::strtod' in the "C" locale;
+ *        decimal numbers with up to 19 significant digits and small
+ *        exponents are converted directly (the result is exact, because
+ *        mantissa and power of 10 are exactly representable);
+ *        everything else is handed over to the C library
+ *
+ *****************************************************************************/
+template<class T>
+conversion_result
+parse_float(const char* first, const char* last, T& value)
+{
+    constexpr int maxExp = max_exact_pow10<T>();
+    constexpr int digits = std::numeric_limits<T>::digits;
+
+    auto p = first;
+    while(p != last && is_space(*p)) ++p;
+
+    bool neg = false;
+    if(p != last && (*p == '+' || *p == '-')) {
+        neg = *p == '-';
+        ++p;
     }
-};
 
-template<>
-struct make<unsigned long int> {
-    static inline unsigned long int from(const char* s) {
-        if(!fwd_to_unsigned_int(s)) return (0);
-        return clamped_on_limits<unsigned long int>(std::strtoull(s,nullptr,10));
+    std::uint64_t m = 0;
+    int sigDigits = 0;
+    int exp10 = 0;
+    bool any = false;
+    bool exact = true;
+
+    const auto add_digit = [&](char c) {
+        any = true;
+        if(m == 0 && c == '0') return;
+        if(sigDigits < 19) {
+            m = m * 10 + std::uint64_t(c - '0');
+            ++sigDigits;
+        } else {
+            exact = false;
+        }
+    };
+
+    for(; p != last && is_digit(*p); ++p) add_digit(*p);
+    //hexadecimal numbers
+    if(p != last && (*p == 'x' || *p == 'X')) exact = false;
+
+    if(p != last && *p == '.') {
+        for(++p; p != last && is_digit(*p); ++p) {
+            add_digit(*p);
+            --exp10;
+        }
     }
-};
+    //no digits: infinity, nan, ...
+    if(!any) exact = false;
 
-template<>
-struct make<unsigned long long int> {
-    static inline unsigned long long int from(const char* s) {
-        if(!fwd_to_unsigned_int(s)) return (0);
-        return clamped_on_limits<unsigned long long int>(std::strtoull(s,nullptr,10));
+    if(exact && p != last && (*p == 'e' || *p == 'E')) {
+        auto q = p + 1;
+        bool negExp = false;
+        if(q != last && (*q == '+' || *q == '-')) {
+            negExp = *q == '-';
+            ++q;
+        }
+        if(q != last && is_digit(*q)) {
+            int e = 0;
+            for(; q != last && is_digit(*q); ++q) {
+                if(e < 100000) e = e * 10 + (*q - '0');
+            }
+            exp10 += negExp ? -e : e;
+            p = q;
+        }
     }
-};
 
-template<>
-struct make<char> {
-    static inline char from(const char* s) {
-        //parse as single character?
-        const auto n = std::strlen(s);
-        if(n == 1) return s[0];
-        //parse as integer
-        return clamped_on_limits<char>(std::strtoll(s,nullptr,10));
+    if(exact && m == 0) {
+        value = neg ? -T(0) : T(0);
+        return conversion_result{p, conversion_status::ok};
     }
-};
 
-template<>
-struct make<short int> {
-    static inline short int from(const char* s) {
-        return clamped_on_limits<short int>(std::strtoll(s,nullptr,10));
+    if(exact && maxExp >= 0 && exp10 >= -maxExp && exp10 <= maxExp &&
+       (digits >= 64 || m <= (std::uint64_t(1) << (digits < 64 ? digits : 0))))
+    {
+        const T v = T(m);
+        value = exp10 < 0 ? v / exact_pow10<T>(-exp10)
+                          : v * exact_pow10<T>(exp10);
+        if(neg) value = -value;
+        return conversion_result{p, conversion_status::ok};
     }
-};
 
-template<>
-struct make<int> {
-    static inline int from(const char* s) {
-        return clamped_on_limits<int>(std::strtoll(s,nullptr,10));
+    return parse_float_slow(first, last, value);
+}
+
+
+
+/*************************************************************************//**
+ *
+ * @brief decimal number that was recognized while matching an argument:
+ *        value = (-1)^negative * significand * 10^exponent;
+ *        'integer' numbers consist only of an optional sign and digits;
+ *        significand and exponent are limited so that the number fits
+ *        into the spare bits of an arg mapping
+ *
+ *****************************************************************************/
+enum class number_kind { none, integer, decimal };
+
+struct scanned_number {
+    static constexpr std::uint64_t max_significand = (std::uint64_t(1) << 52) - 1;
+    static constexpr int min_exponent = -16;
+    static constexpr int max_exponent = 15;
+
+    number_kind kind = number_kind::none;
+    bool negative = false;
+    int exponent = 0;
+    std::uint64_t significand = 0;
+
+    explicit operator bool() const noexcept {
+        return kind != number_kind::none;
     }
 };
 
-template<>
-struct make<long int> {
-    static inline long int from(const char* s) {
-        return clamped_on_limits<long int>(std::strtoll(s,nullptr,10));
+
+/*************************************************************************//**
+ *
+ * @brief returns true if [first,last) is a plain number
+ *        [+-]digits[.digits][(e|E)[+-]digits] that starts with a sign or
+ *        a digit and has at least one digit before the exponent
+ *        ('decimal' = false: [+-]digits);
+ *        in that case 'num' is set to its value, if it is representable
+ *        as a 'scanned_number', and to 'none' otherwise
+ *
+ *****************************************************************************/
+inline bool
+scan_number(const char* first, const char* last, bool decimal,
+            scanned_number& num) noexcept
+{
+    if(first == last || *first == '.') return false;
+
+    auto p = first;
+    bool neg = false;
+    if(p != last && (*p == '+' || *p == '-')) {
+        neg = *p == '-';
+        ++p;
+    }
+
+    std::uint64_t m = 0;
+    int exp10 = 0;
+    bool any = false;
+    bool fits = true;
+    bool plain = true;
+
+    const auto add_digit = [&](char c) {
+        any = true;
+        const auto d = std::uint64_t(c - '0');
+        if(m > (scanned_number::max_significand - d) / 10) fits = false;
+        else m = m * 10 + d;
+    };
+
+    for(; p != last && is_digit(*p); ++p) add_digit(*p);
+
+    if(decimal && p != last && *p == '.') {
+        plain = false;
+        for(++p; p != last && is_digit(*p); ++p) {
+            add_digit(*p);
+            --exp10;
+        }
+    }
+    if(!any) return false;
+
+    if(decimal && p != last && (*p == 'e' || *p == 'E')) {
+        plain = false;
+        ++p;
+        bool negExp = false;
+        if(p != last && (*p == '+' || *p == '-')) {
+            negExp = *p == '-';
+            ++p;
+        }
+        if(p == last || !is_digit(*p)) return false;
+        int e = 0;
+        for(; p != last && is_digit(*p); ++p) {
+            if(e < 100000) e = e * 10 + (*p - '0');
+        }
+        exp10 += negExp ? -e : e;
+    }
+    if(p != last) return false;
+
+    num = scanned_number{};
+    if(fits && exp10 >= scanned_number::min_exponent &&
+               exp10 <= scanned_number::max_exponent)
+    {
+        num.kind = plain ? number_kind::integer : number_kind::decimal;
+        num.negative = neg;
+        num.exponent = exp10;
+        num.significand = m;
+    }
+    return true;
+}
+
+
+/*************************************************************************//**
+ *
+ * @brief converts a scanned number to T with the same result that
+ *        'parse_integer' / 'parse_float' would produce for its string;
+ *        returns false if that is not possible without the string
+ *
+ *****************************************************************************/
+template<class T>
+inline typename std::enable_if<std::is_integral<T>::value,bool>::type
+convert_scanned(const scanned_number& num, T& value) noexcept
+{
+    if(num.kind != number_kind::integer) return false;
+    if(num.negative && !std::is_signed<T>::value) {
+        value = T(0);
+    }
+    else if(std::is_signed<T>::value) {
+        const auto v = static_cast<long long int>(num.significand);
+        value = clamped_on_limits<T>(num.negative ? -v : v);
+    }
+    else {
+        value = clamped_on_limits<T>(
+            static_cast<unsigned long long int>(num.significand));
+    }
+    return true;
+}
+
+template<class T>
+inline typename std::enable_if<std::is_floating_point<T>::value,bool>::type
+convert_scanned(const scanned_number& num, T& value) noexcept
+{
+    constexpr int maxExp = max_exact_pow10<T>();
+    constexpr int digits = std::numeric_limits<T>::digits;
+
+    if(!num) return false;
+    const auto m = num.significand;
+    if(m == 0) {
+        value = num.negative ? -T(0) : T(0);
+        return true;
+    }
+    if(maxExp < 0 || num.exponent < -maxExp || num.exponent > maxExp ||
+       (digits < 64 && m > (std::uint64_t(1) << (digits < 64 ? digits : 0))))
+    {
+        return false;
+    }
+    const T v = T(m);
+    value = num.exponent < 0 ? v / exact_pow10<T>(-num.exponent)
+                             : v * exact_pow10<T>(num.exponent);
+    if(num.negative) value = -value;
+    return true;
+}
+
+
+
+
+/*************************************************************************//**
+ *
+ * @brief type conversion helpers
+ *
+ *****************************************************************************/
+template<class T>
+struct make {
+    static inline T from(const char* s) {
+        if(!s) return false;
+        //a conversion from const char* to / must exist
+        return static_cast<T>(s);
+    }
+    static inline T from(const char* first, const char* last) {
+        return from(std::string(first, last).c_str());
     }
 };
 
 template<>
-struct make<long long int> {
-    static inline long long int from(const char* s) {
-        return (std::strtoll(s,nullptr,10));
+struct make<bool> {
+    static inline bool from(const char* s) {
+        if(!s) return false;
+        return static_cast<bool>(s);
+    }
+    static inline bool from(const char* first, const char*) {
+        return static_cast<bool>(first);
     }
 };
 
-template<>
-struct make<float> {
-    static inline float from(const char* s) {
-        return (std::strtof(s,nullptr));
+/** @brief numbers: string is converted with 'parse_integer'/'parse_float'
+ *         ignoring trailing characters */
+template<class T, bool = std::is_floating_point<T>::value>
+struct make_number {
+    static inline T from(const char* first, const char* last) {
+        T value = T(0);
+        parse_integer(first, last, value);
+        return value;
+    }
+    static inline T from(const char* s) {
+        if(!s) return T(0);
+        return from(s, s + std::strlen(s));
     }
 };
 
-template<>
-struct make<double> {
-    static inline double from(const char* s) {
-        return (std::strtod(s,nullptr));
+template<class T>
+struct make_number<T,true> {
+    static inline T from(const char* first, const char* last) {
+        T value = T(0);
+        parse_float(first, last, value);
+        return value;
+    }
+    static inline T from(const char* s) {
+        if(!s) return T(0);
+        return from(s, s + std::strlen(s));
     }
 };
 
+template<> struct make<unsigned char> : make_number<unsigned char> {};
+template<> struct make<unsigned short int> : make_number<unsigned short int> {};
+template<> struct make<unsigned int> : make_number<unsigned int> {};
+template<> struct make<unsigned long int> : make_number<unsigned long int> {};
+template<> struct make<unsigned long long int> : make_number<unsigned long long int> {};
+template<> struct make<short int> : make_number<short int> {};
+template<> struct make<int> : make_number<int> {};
+template<> struct make<long int> : make_number<long int> {};
+template<> struct make<long long int> : make_number<long long int> {};
+template<> struct make<float> : make_number<float> {};
+template<> struct make<double> : make_number<double> {};
+template<> struct make<long double> : make_number<long double> {};
+
 template<>
-struct make<long double> {
-    static inline long double from(const char* s) {
-        return (std::strtold(s,nullptr));
+struct make<char> {
+    static inline char from(const char* first, const char* last) {
+        //parse as single character?
+        if(last - first == 1) return *first;
+        //parse as integer
+        return make_number<char>::from(first, last);
+    }
+    static inline char from(const char* s) {
+        if(!s) return 0;
+        if(s[0] && !s[1]) return s[0];
+        return make_number<char>::from(s);
     }
 };
 
@@ -469,6 +854,9 @@ struct make<std::string> {
     static inline std::string from(const char* s) {
         return std::string(s);
     }
+    static inline std::string from(const char* first, const char* last) {
+        return std::string(first, last);
+    }
 };
 
 
@@ -592,6 +980,22 @@ private:
 
 
 
+/*************************************************************************//**
+ *
+ * @brief true, if values of type T (or elements of a vector<T>) are made
+ *        with 'make_number' and can thus be set from a scanned number
+ *
+ *****************************************************************************/
+template<class T>
+struct is_number_target :
+    std::integral_constant<bool, std::is_base_of<make_number<T>,make<T>>::value>
+{};
+
+template<class T>
+struct is_number_target<std::vector<T>> : is_number_target<T> {};
+
+
+
 /*************************************************************************//**
  *
  * @brief makes a value from a string and assigns it to an object
@@ -608,6 +1012,12 @@ public:
         if(t_ && s) *t_ = detail::make<T>::from(s);
     }
 
+    /** @brief assigns an argument's value that was already scanned during
+     *         matching; returns false if the argument string is needed */
+    bool operator () (const scanned_number& num) const {
+        return t_ && convert_scanned(num, *t_);
+    }
+
 private:
     T* t_;
 };
@@ -627,6 +1037,24 @@ public:
         if(t_ && s) t_->push_back(detail::make<T>::from(s));
     }
 
+    bool operator () (const scanned_number& num) const {
+        T value = T(0);
+        if(!t_ || !convert_scanned(num, value)) return false;
+        t_->push_back(value);
+        return true;
+    }
+
+    /** @brief makes room for 'n' more elements;
+     *         grows geometrically, so that appending to the same vector
+     *         in many parse calls doesn't reallocate every time */
+    void reserve(std::size_t n) const {
+        if(!t_) return;
+        const auto size = t_->size() + n;
+        if(t_->capacity() < size) {
+            t_->reserve(std::max(size, 2 * t_->capacity()));
+        }
+    }
+
 private:
     std::vector<T>* t_;
 };
@@ -652,60 +1080,520 @@ private:
 };
 
 
-} // namespace detail
-
-
-
-
-
 
 /*************************************************************************//**
  *
- * @brief string matching and processing tools
+ * @brief capabilities of action types beyond being callable;
+ *        target setters can take already scanned numbers and
+ *        vector targets can reserve space in advance
  *
  *****************************************************************************/
+template<class F>
+struct action_traits {
+    static constexpr bool sets_numbers = false;
+    static constexpr bool reserves = false;
+};
 
-namespace str {
-
+template<class T>
+struct action_traits<map_arg_to<T>> {
+    static constexpr bool sets_numbers = is_number_target<T>::value;
+    static constexpr bool reserves = false;
+};
 
-/*************************************************************************//**
- *
- * @brief converts string to value of target type 'T'
- *
- *****************************************************************************/
 template<class T>
-T make(const arg_string& s)
-{
-    return detail::make<T>::from(s);
-}
+struct action_traits<map_arg_to<std::vector<T>>> {
+    static constexpr bool sets_numbers = is_number_target<T>::value;
+    static constexpr bool reserves = true;
+};
 
 
 
 /*************************************************************************//**
  *
- * @brief removes trailing whitespace from string
+ * @brief events that parameter actions can be attached to
  *
  *****************************************************************************/
-template<class C, class T, class A>
-inline void
-trimr(std::basic_string<C,T,A>& s)
-{
-    if(s.empty()) return;
+enum class action_kind : unsigned char {
+    arg, repeated, missing, blocked, conflicted
+};
 
-    s.erase(
-        std::find_if_not(s.rbegin(), s.rend(),
-                         [](char c) { return std::isspace(c);} ).base(),
-        s.end() );
-}
 
 
 /*************************************************************************//**
  *
- * @brief removes leading whitespace from string
+ * @brief stores a callable of type 'F' in buffer 'Storage' (4 pointers,
+ *        maximally aligned) or - if it doesn't fit - on the heap;
+ *        building block of the type-erased callables below
  *
  *****************************************************************************/
-template<class C, class T, class A>
-inline void
+struct erased_storage {
+    alignas(std::max_align_t) unsigned char bytes[4 * sizeof(void*)];
+};
+
+template<class Storage, class F>
+struct fits_storage : std::integral_constant<bool,
+    sizeof(F) <= sizeof(Storage) &&
+    alignof(Storage) % alignof(F) == 0 &&
+    std::is_nothrow_move_constructible<F>::value>
+{};
+
+
+/** @brief callable stored in the inline buffer */
+template<class Storage, class F, bool Inline = fits_storage<Storage,F>::value>
+struct erased_holder {
+    static F& get(Storage& s) noexcept {
+        return *reinterpret_cast<F*>(&s);
+    }
+    static const F& get(const Storage& s) noexcept {
+        return *reinterpret_cast<const F*>(&s);
+    }
+    template<class G>
+    static void create(Storage& s, G&& g) {
+        ::new(static_cast<void*>(&s)) F(std::forward<G>(g));
+    }
+    static void copy(const Storage& src, Storage& dst) {
+        create(dst, get(src));
+    }
+    static void move(Storage& src, Storage& dst) noexcept {
+        create(dst, std::move(get(src)));
+        get(src).~F();
+    }
+    static void destroy(Storage& s) noexcept { get(s).~F(); }
+};
+
+/** @brief callable stored on the heap */
+template<class Storage, class F>
+struct erased_holder<Storage,F,false> {
+    static F& get(Storage& s) noexcept {
+        return **reinterpret_cast<F**>(&s);
+    }
+    static const F& get(const Storage& s) noexcept {
+        return **reinterpret_cast<F* const*>(&s);
+    }
+    template<class G>
+    static void create(Storage& s, G&& g) {
+        *reinterpret_cast<F**>(&s) = new F(std::forward<G>(g));
+    }
+    static void copy(const Storage& src, Storage& dst) {
+        create(dst, get(src));
+    }
+    static void move(Storage& src, Storage& dst) noexcept {
+        *reinterpret_cast<F**>(&dst) = *reinterpret_cast<F**>(&src);
+    }
+    static void destroy(Storage& s) noexcept { delete &get(s); }
+};
+
+
+
+/*************************************************************************//**
+ *
+ * @brief type-erased parameter action;
+ *        callables that are not larger than 4 pointers are stored inline,
+ *        only larger ones are allocated on the heap
+ *
+ *****************************************************************************/
+class param_action
+{
+    using storage = erased_storage;
+
+    /** @brief how a callable is invoked */
+    struct pass_arg {};
+    struct pass_index {};
+    struct pass_nothing {};
+
+    struct operations {
+        action_kind kind;
+        bool setsNumbers;
+        bool reserves;
+        void (*call)(storage&, const char*, int);
+        bool (*callNumber)(storage&, const scanned_number&);
+        void (*reserve)(storage&, std::size_t);
+        void (*copy)(const storage&, storage&);
+        void (*move)(storage&, storage&);
+        void (*destroy)(storage&);
+    };
+
+public:
+    //---------------------------------------------------------------
+    param_action() noexcept: ops_{nullptr} {}
+
+    /** @brief makes an action for event 'Kind'; argument actions are called
+     *         with the argument string if 'f' accepts a 'const char*',
+     *         all other actions with the argument index if 'f' accepts
+     *         an 'int'
+     */
+    template<action_kind Kind, class F>
+    static param_action
+    make(F&& f) {
+        using fn = typename std::decay<F>::type;
+        using mode = typename std::conditional<Kind == action_kind::arg,
+            typename std::conditional<
+                traits::is_callable<fn,void(const char*)>::value,
+                pass_arg, pass_nothing>::type,
+            typename std::conditional<
+                traits::is_callable<fn,void(int)>::value,
+                pass_index, pass_nothing>::type
+            >::type;
+
+        using model_t = model<Kind,fn,mode,fits_inline<fn>::value>;
+
+        param_action a;
+        model_t::create(a.buf_, std::forward<F>(f));
+        a.ops_ = &model_t::ops;
+        return a;
+    }
+
+    //---------------------------------------------------------------
+    param_action(const param_action& src): ops_{src.ops_} {
+        if(ops_) ops_->copy(src.buf_, buf_);
+    }
+
+    param_action(param_action&& src) noexcept: ops_{src.ops_} {
+        if(ops_) ops_->move(src.buf_, buf_);
+        src.ops_ = nullptr;
+    }
+
+    param_action& operator = (const param_action& src) {
+        if(this != &src) *this = param_action(src);
+        return *this;
+    }
+
+    param_action& operator = (param_action&& src) noexcept {
+        if(this != &src) {
+            reset();
+            ops_ = src.ops_;
+            if(ops_) ops_->move(src.buf_, buf_);
+            src.ops_ = nullptr;
+        }
+        return *this;
+    }
+
+    ~param_action() { reset(); }
+
+    //---------------------------------------------------------------
+    explicit operator bool() const noexcept { return ops_ != nullptr; }
+
+    action_kind kind() const noexcept { return ops_->kind; }
+
+    //---------------------------------------------------------------
+    /** @brief calls argument action */
+    void operator () (const char* arg) const { ops_->call(buf_, arg, 0); }
+
+    /** @brief calls event action */
+    void operator () (int index) const { ops_->call(buf_, nullptr, index); }
+
+    /** @brief sets target from an already scanned number;
+     *         returns false if the argument string is needed */
+    bool operator () (const scanned_number& num) const {
+        return ops_->setsNumbers && ops_->callNumber(buf_, num);
+    }
+
+    //---------------------------------------------------------------
+    /** @brief true, if the action's target can reserve space for values */
+    bool reserves_targets() const noexcept {
+        return ops_ && ops_->reserves;
+    }
+    /** @brief makes target reserve space for 'n' more values */
+    void reserve_targets(std::size_t n) const {
+        if(reserves_targets()) ops_->reserve(buf_, n);
+    }
+
+private:
+    //---------------------------------------------------------------
+    template<class F>
+    using fits_inline = fits_storage<storage,F>;
+
+    //---------------------------------------------------------------
+    template<class F>
+    static void invoke(F& f, const char* arg, int, pass_arg) { f(arg); }
+    template<class F>
+    static void invoke(F& f, const char*, int idx, pass_index) { f(idx); }
+    template<class F>
+    static void invoke(F& f, const char*, int, pass_nothing) { f(); }
+
+    template<class F>
+    static bool invoke_number(F& f, const scanned_number& num, std::true_type) {
+        return f(num);
+    }
+    template<class F>
+    static bool invoke_number(F&, const scanned_number&, std::false_type) {
+        return false;
+    }
+
+    template<class F>
+    static void invoke_reserve(F& f, std::size_t n, std::true_type) {
+        f.reserve(n);
+    }
+    template<class F>
+    static void invoke_reserve(F&, std::size_t, std::false_type) {}
+
+    //---------------------------------------------------------------
+    template<class F, bool Inline>
+    using holder = erased_holder<storage,F,Inline>;
+
+    //---------------------------------------------------------------
+    template<action_kind Kind, class F, class Mode, bool Inline>
+    struct model : holder<F,Inline> {
+        using holder<F,Inline>::get;
+
+        static void call(storage& s, const char* arg, int idx) {
+            invoke(get(s), arg, idx, Mode{});
+        }
+        static bool call_number(storage& s, const scanned_number& num) {
+            return invoke_number(get(s), num, std::integral_constant<bool,
+                                 action_traits<F>::sets_numbers>{});
+        }
+        static void reserve(storage& s, std::size_t n) {
+            invoke_reserve(get(s), n, std::integral_constant<bool,
+                           action_traits<F>::reserves>{});
+        }
+
+        static const operations ops;
+    };
+
+    //---------------------------------------------------------------
+    void reset() noexcept {
+        if(ops_) ops_->destroy(buf_);
+        ops_ = nullptr;
+    }
+
+    //---------------------------------------------------------------
+    mutable storage buf_;
+    const operations* ops_;
+};
+
+template<action_kind Kind, class F, class Mode, bool Inline>
+const param_action::operations
+param_action::model<Kind,F,Mode,Inline>::ops = {
+    Kind,
+    action_traits<F>::sets_numbers,
+    action_traits<F>::reserves,
+    &model::call,
+    &model::call_number,
+    &model::reserve,
+    &model::copy,
+    &model::move,
+    &model::destroy
+};
+
+
+
+/*************************************************************************//**
+ *
+ * @brief type-erased match operation of a parameter;
+ *        can be called with an argument string and - if the callable
+ *        supports it - with a number that is scanned while matching;
+ *        callables that also accept a character range [first,last)
+ *        can match parts of an argument in place;
+ *        callables that are not larger than 4 pointers are stored inline
+ *
+ *****************************************************************************/
+class param_matcher
+{
+    using storage = erased_storage;
+
+    struct operations {
+        subrange (*match)(storage&, const arg_string&);
+        subrange (*match_at)(storage&, const arg_string&,
+                             arg_string::size_type);
+        subrange (*scan)(storage&, const arg_string&, scanned_number&);
+        void (*copy)(const storage&, storage&);
+        void (*move)(storage&, storage&);
+        void (*destroy)(storage&);
+    };
+
+public:
+    //---------------------------------------------------------------
+    param_matcher() noexcept: ops_{nullptr} {}
+
+    template<class F, class = typename std::enable_if<
+        !std::is_same<typename std::decay<F>::type,param_matcher>::value>::type>
+    explicit
+    param_matcher(F&& f): ops_{&model<typename std::decay<F>::type>::ops} {
+        model<typename std::decay<F>::type>::create(buf_, std::forward<F>(f));
+    }
+
+    //---------------------------------------------------------------
+    param_matcher(const param_matcher& src): ops_{src.ops_} {
+        if(ops_) ops_->copy(src.buf_, buf_);
+    }
+
+    param_matcher(param_matcher&& src) noexcept: ops_{src.ops_} {
+        if(ops_) ops_->move(src.buf_, buf_);
+        src.ops_ = nullptr;
+    }
+
+    param_matcher& operator = (const param_matcher& src) {
+        if(this != &src) *this = param_matcher(src);
+        return *this;
+    }
+
+    param_matcher& operator = (param_matcher&& src) noexcept {
+        if(this != &src) {
+            reset();
+            ops_ = src.ops_;
+            if(ops_) ops_->move(src.buf_, buf_);
+            src.ops_ = nullptr;
+        }
+        return *this;
+    }
+
+    ~param_matcher() { reset(); }
+
+    //---------------------------------------------------------------
+    explicit operator bool() const noexcept { return ops_ != nullptr; }
+
+    /** @brief matches argument */
+    subrange operator () (const arg_string& arg) const {
+        return ops_->match(buf_, arg);
+    }
+
+    /** @brief matches argument; numbers are also scanned into 'num' */
+    subrange operator () (const arg_string& arg, scanned_number& num) const {
+        return ops_->scan(buf_, arg, num);
+    }
+
+    /** @brief same as '(*this)(arg.substr(at))', but the substring is
+     *         only copied if the callable doesn't accept a character range
+     */
+    subrange operator () (const arg_string& arg,
+                          arg_string::size_type at) const
+    {
+        return ops_->match_at(buf_, arg, at);
+    }
+
+private:
+    //---------------------------------------------------------------
+    template<class F>
+    static subrange invoke_at(F& f, const arg_string& arg,
+                              arg_string::size_type at, std::true_type)
+    {
+        return f(arg.data() + at, arg.data() + arg.size());
+    }
+    template<class F>
+    static subrange invoke_at(F& f, const arg_string& arg,
+                              arg_string::size_type at, std::false_type)
+    {
+        return f(arg.substr(at));
+    }
+
+    template<class F>
+    static subrange invoke_scan(F& f, const arg_string& arg,
+                                scanned_number& num, std::true_type)
+    {
+        return f(arg, num);
+    }
+    template<class F>
+    static subrange invoke_scan(F& f, const arg_string& arg,
+                                scanned_number& num, std::false_type)
+    {
+        num = scanned_number{};
+        return f(arg);
+    }
+
+    //---------------------------------------------------------------
+    template<class F>
+    struct model : erased_holder<storage,F> {
+        using erased_holder<storage,F>::get;
+
+        static subrange match(storage& s, const arg_string& arg) {
+            return get(s)(arg);
+        }
+        static subrange match_at(storage& s, const arg_string& arg,
+                                 arg_string::size_type at)
+        {
+            return invoke_at(get(s), arg, at, std::integral_constant<bool,
+                traits::is_callable<F,subrange(const char*,
+                                               const char*)>::value>{});
+        }
+        static subrange scan(storage& s, const arg_string& arg,
+                             scanned_number& num)
+        {
+            return invoke_scan(get(s), arg, num, std::integral_constant<bool,
+                traits::is_callable<F,subrange(const arg_string&,
+                                               scanned_number&)>::value>{});
+        }
+
+        static const operations ops;
+    };
+
+    //---------------------------------------------------------------
+    void reset() noexcept {
+        if(ops_) ops_->destroy(buf_);
+        ops_ = nullptr;
+    }
+
+    //---------------------------------------------------------------
+    mutable storage buf_;
+    const operations* ops_;
+};
+
+template<class F>
+const param_matcher::operations
+param_matcher::model<F>::ops = {
+    &model::match,
+    &model::match_at,
+    &model::scan,
+    &model::copy,
+    &model::move,
+    &model::destroy
+};
+
+
+} // namespace detail
+
+
+
+
+
+
+/*************************************************************************//**
+ *
+ * @brief string matching and processing tools
+ *
+ *****************************************************************************/
+
+namespace str {
+
+
+/*************************************************************************//**
+ *
+ * @brief converts string to value of target type 'T'
+ *
+ *****************************************************************************/
+template<class T>
+T make(const arg_string& s)
+{
+    return detail::make<T>::from(s.data(), s.data() + s.size());
+}
+
+
+
+/*************************************************************************//**
+ *
+ * @brief removes trailing whitespace from string
+ *
+ *****************************************************************************/
+template<class C, class T, class A>
+inline void
+trimr(std::basic_string<C,T,A>& s)
+{
+    if(s.empty()) return;
+
+    s.erase(
+        std::find_if_not(s.rbegin(), s.rend(),
+                         [](char c) { return std::isspace(c);} ).base(),
+        s.end() );
+}
+
+
+/*************************************************************************//**
+ *
+ * @brief removes leading whitespace from string
+ *
+ *****************************************************************************/
+template<class C, class T, class A>
+inline void
 triml(std::basic_string<C,T,A>& s)
 {
     if(s.empty()) return;
@@ -924,34 +1812,57 @@ substring_match(const std::basic_string<C,T,A>& subject,
 
 /*************************************************************************//**
  *
- * @brief returns first substring match (pos,len) within the input string
- *        that represents a number
- *        (with at maximum one decimal point and digit separators)
+ * @brief trims whitespace from both ends of the character range
+ *        [first,last) without modifying it
  *
  *****************************************************************************/
-template<class C, class T, class A>
+template<class C>
+inline void
+trimmed_range(const C*& first, const C*& last)
+{
+    const auto space = [](char c) { return std::isspace(c) != 0; };
+    first = std::find_if_not(first, last, space);
+    while(last != first && space(*(last-1))) --last;
+}
+
+
+
+/*************************************************************************//**
+ *
+ * @brief returns first substring match (pos,len) within the character range
+ *        [first,last) that represents a number
+ *        (with at maximum one decimal point and digit separators);
+ *        leading and trailing whitespace is ignored, 'pos' is relative
+ *        to the first non-whitespace character
+ *
+ *****************************************************************************/
+template<class C>
 subrange
-first_number_match(std::basic_string<C,T,A> s,
+first_number_match(const C* first, const C* last,
                    C digitSeparator = C(','),
                    C decimalPoint = C('.'),
                    C exponential = C('e'))
 {
-    using string_t = std::basic_string<C,T,A>;
+    constexpr auto npos = arg_string::npos;
 
-    str::trim(s);
-    if(s.empty()) return subrange{};
+    trimmed_range(first, last);
+    if(first == last) return subrange{};
+    const C* s = first;
+    const auto n = std::size_t(last - first);
 
-    auto i = s.find_first_of("0123456789+-");
-    if(i == string_t::npos) {
-        i = s.find(decimalPoint);
-        if(i == string_t::npos) return subrange{};
+    auto i = std::size_t(std::find_if(first, last, [](C c) {
+            return (c >= '0' && c <= '9') || c == '+' || c == '-';
+        }) - first);
+    if(i == n) {
+        i = std::size_t(std::find(first, last, decimalPoint) - first);
+        if(i == n) return subrange{};
     }
 
     bool point = false;
     bool sep = false;
-    auto exp = string_t::npos;
+    auto exp = npos;
     auto j = i + 1;
-    for(; j < s.size(); ++j) {
+    for(; j < n; ++j) {
         if(s[j] == digitSeparator) {
             if(!sep) sep = true; else break;
         }
@@ -959,13 +1870,13 @@ first_number_match(std::basic_string<C,T,A> s,
             sep = false;
             if(s[j] == decimalPoint) {
                 //only one decimal point before exponent allowed
-                if(!point && exp == string_t::npos) point = true; else break;
+                if(!point && exp == npos) point = true; else break;
             }
             else if(std::tolower(s[j]) == std::tolower(exponential)) {
                 //only one exponent separator allowed
-                if(exp == string_t::npos) exp = j; else break;
+                if(exp == npos) exp = j; else break;
             }
-            else if(exp != string_t::npos && (exp+1) == j) {
+            else if(exp != npos && (exp+1) == j) {
                 //only sign or digit after exponent separator
                 if(s[j] != '+' && s[j] != '-' && !std::isdigit(s[j])) break;
             }
@@ -981,30 +1892,47 @@ first_number_match(std::basic_string<C,T,A> s,
     return subrange{i,j-i};
 }
 
+//-------------------------------------------------------------------
+template<class C, class T, class A>
+inline subrange
+first_number_match(const std::basic_string<C,T,A>& s,
+                   C digitSeparator = C(','),
+                   C decimalPoint = C('.'),
+                   C exponential = C('e'))
+{
+    return first_number_match(s.data(), s.data() + s.size(),
+                              digitSeparator, decimalPoint, exponential);
+}
+
 
 
 /*************************************************************************//**
  *
- * @brief returns first substring match (pos,len)
- *        that represents an integer (with optional digit separators)
+ * @brief returns first substring match (pos,len) within the character range
+ *        [first,last) that represents an integer
+ *        (with optional digit separators);
+ *        leading and trailing whitespace is ignored, 'pos' is relative
+ *        to the first non-whitespace character
  *
  *****************************************************************************/
-template<class C, class T, class A>
+template<class C>
 subrange
-first_integer_match(std::basic_string<C,T,A> s,
+first_integer_match(const C* first, const C* last,
                     C digitSeparator = C(','))
 {
-    using string_t = std::basic_string<C,T,A>;
-
-    str::trim(s);
-    if(s.empty()) return subrange{};
+    trimmed_range(first, last);
+    if(first == last) return subrange{};
+    const C* s = first;
+    const auto n = std::size_t(last - first);
 
-    auto i = s.find_first_of("0123456789+-");
-    if(i == string_t::npos) return subrange{};
+    const auto i = std::size_t(std::find_if(first, last, [](C c) {
+            return (c >= '0' && c <= '9') || c == '+' || c == '-';
+        }) - first);
+    if(i == n) return subrange{};
 
     bool sep = false;
     auto j = i + 1;
-    for(; j < s.size(); ++j) {
+    for(; j < n; ++j) {
         if(s[j] == digitSeparator) {
             if(!sep) sep = true; else break;
         }
@@ -1020,6 +1948,16 @@ first_integer_match(std::basic_string<C,T,A> s,
     return subrange{i,j-i};
 }
 
+//-------------------------------------------------------------------
+template<class C, class T, class A>
+inline subrange
+first_integer_match(const std::basic_string<C,T,A>& s,
+                    C digitSeparator = C(','))
+{
+    return first_integer_match(s.data(), s.data() + s.size(),
+                               digitSeparator);
+}
+
 
 
 /*************************************************************************//**
@@ -1174,54 +2112,156 @@ namespace detail {
 
 /*************************************************************************//**
  *
- * @brief mixin that provides action definition and execution
+ * @brief sequence container that stores up to N elements inline and
+ *        only uses heap memory if it grows beyond that;
+ *        supports the subset of the std::vector interface needed by
+ *        traversers (elements need to be default constructible)
  *
  *****************************************************************************/
-template<class Derived>
-class action_provider
+template<class T, std::size_t N>
+class small_vector
 {
-private:
-    //---------------------------------------------------------------
-    using simple_action = std::function<void()>;
-    using arg_action    = std::function<void(const char*)>;
-    using index_action  = std::function<void(int)>;
+public:
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using iterator        = T*;
+    using const_iterator  = const T*;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
-    //-----------------------------------------------------
-    class simple_action_adapter {
-    public:
-        simple_action_adapter() = default;
-        simple_action_adapter(const simple_action& a): action_(a) {}
-        simple_action_adapter(simple_action&& a): action_(std::move(a)) {}
-        void operator() (const char*) const { action_(); }
-        void operator() (int) const { action_(); }
-    private:
-        simple_action action_;
-    };
+    bool empty() const noexcept { return size_ == 0; }
+    size_type size() const noexcept { return size_; }
 
+    T*       data()       noexcept { return heap_.empty() ? inline_ : heap_.data(); }
+    const T* data() const noexcept { return heap_.empty() ? inline_ : heap_.data(); }
 
-public:
-    //---------------------------------------------------------------
-    /** @brief adds an action that has an operator() that is callable
-     *         with a 'const char*' argument */
-    Derived&
-    call(arg_action a) {
-        argActions_.push_back(std::move(a));
-        return *static_cast<Derived*>(this);
+    iterator begin() noexcept { return data(); }
+    iterator end()   noexcept { return data() + size_; }
+    const_iterator begin() const noexcept { return data(); }
+    const_iterator end()   const noexcept { return data() + size_; }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    reverse_iterator rend()   noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
     }
 
-    /** @brief adds an action that has an operator()() */
-    Derived&
-    call(simple_action a) {
-        argActions_.push_back(simple_action_adapter(std::move(a)));
-        return *static_cast<Derived*>(this);
+    T&       operator [] (size_type i)       noexcept { return data()[i]; }
+    const T& operator [] (size_type i) const noexcept { return data()[i]; }
+
+    T&       front()       noexcept { return data()[0]; }
+    const T& front() const noexcept { return data()[0]; }
+    T&       back()        noexcept { return data()[size_-1]; }
+    const T& back()  const noexcept { return data()[size_-1]; }
+
+    void push_back(const T& x) { push(x); }
+    void push_back(T&& x)      { push(std::move(x)); }
+
+    template<class... Args>
+    void emplace_back(Args&&... args) {
+        push(T(std::forward<Args>(args)...));
+    }
+
+    void pop_back() noexcept(nothrow_reset) {
+        --size_;
+        //once the heap is empty, the (empty) inline storage is used again
+        if(!heap_.empty()) heap_.pop_back();
+        else reset(inline_[size_]);
+    }
+
+    iterator erase(iterator first, iterator last) {
+        const auto i = first - begin();
+        std::move(last, end(), first);
+        for(auto n = last - first; n > 0; --n) pop_back();
+        return begin() + i;
+    }
+
+    void clear() noexcept(nothrow_reset) {
+        if(heap_.empty()) {
+            for(size_type i = 0; i < size_; ++i) reset(inline_[i]);
+        }
+        size_ = 0;
+        heap_.clear();
     }
 
+private:
+    static constexpr bool nothrow_reset =
+        std::is_nothrow_default_constructible<T>::value &&
+        std::is_nothrow_move_assignable<T>::value;
+
+    /** @brief releases resources held by an unused inline element */
+    static void reset(T& x) noexcept(nothrow_reset) { x = T{}; }
+
+    template<class X>
+    void push(X&& x) {
+        if(heap_.empty()) {
+            if(size_ < N) {
+                inline_[size_] = std::forward<X>(x);
+                ++size_;
+                return;
+            }
+            //inline storage exhausted => move all elements to heap
+            //('x' might refer to an inline element)
+            T last (std::forward<X>(x));
+            heap_.reserve(2 * N);
+            heap_.assign(std::make_move_iterator(inline_),
+                         std::make_move_iterator(inline_ + N));
+            heap_.push_back(std::move(last));
+            for(auto& e : inline_) reset(e);
+            ++size_;
+            return;
+        }
+        heap_.push_back(std::forward<X>(x));
+        ++size_;
+    }
+
+    T inline_[N];
+    size_type size_ = 0;
+    std::vector<T> heap_;
+};
+
+
+
+/*************************************************************************//**
+ *
+ * @brief mixin that provides action definition and execution
+ *
+ *****************************************************************************/
+template<class Derived>
+class action_provider
+{
+    //---------------------------------------------------------------
+    template<class Action>
+    using if_arg_action = typename std::enable_if<
+        traits::is_callable<Action,void(const char*)>::value ||
+        traits::is_callable<Action,void()>::value, Derived&>::type;
+
+    template<class Action>
+    using if_index_action = typename std::enable_if<
+        traits::is_callable<Action,void(int)>::value ||
+        traits::is_callable<Action,void()>::value, Derived&>::type;
+
+
+public:
+    //---------------------------------------------------------------
     /** @brief adds an action that has an operator() that is callable
-     *         with a 'const char*' argument */
-    Derived& operator () (arg_action a)    { return call(std::move(a)); }
+     *         with a 'const char*' argument or an operator()() */
+    template<class Action>
+    if_arg_action<Action>
+    call(Action&& a) {
+        return add<action_kind::arg>(std::forward<Action>(a));
+    }
 
-    /** @brief adds an action that has an operator()() */
-    Derived& operator () (simple_action a) { return call(std::move(a)); }
+    /** @brief adds an action that has an operator() that is callable
+     *         with a 'const char*' argument or an operator()() */
+    template<class Action>
+    if_arg_action<Action>
+    operator () (Action&& a) {
+        return call(std::forward<Action>(a));
+    }
 
 
     //---------------------------------------------------------------
@@ -1246,83 +2286,51 @@ public:
 
     //---------------------------------------------------------------
     /** @brief adds an action that will be called if a parameter
-     *         matches an argument for the 2nd, 3rd, 4th, ... time
-     */
-    Derived&
-    if_repeated(simple_action a) {
-        repeatActions_.push_back(simple_action_adapter{std::move(a)});
-        return *static_cast<Derived*>(this);
-    }
-    /** @brief adds an action that will be called with the argument's
-     *         index if a parameter matches an argument for
-     *         the 2nd, 3rd, 4th, ... time
+     *         matches an argument for the 2nd, 3rd, 4th, ... time;
+     *         the action may take the argument's index as 'int'
      */
-    Derived&
-    if_repeated(index_action a) {
-        repeatActions_.push_back(std::move(a));
-        return *static_cast<Derived*>(this);
+    template<class Action>
+    if_index_action<Action>
+    if_repeated(Action&& a) {
+        return add<action_kind::repeated>(std::forward<Action>(a));
     }
 
 
     //---------------------------------------------------------------
     /** @brief adds an action that will be called if a required parameter
-     *         is missing
-     */
-    Derived&
-    if_missing(simple_action a) {
-        missingActions_.push_back(simple_action_adapter{std::move(a)});
-        return *static_cast<Derived*>(this);
-    }
-    /** @brief adds an action that will be called if a required parameter
-     *         is missing; the action will get called with the index of
-     *         the command line argument where the missing event occurred first
+     *         is missing; the action may take the index of the command
+     *         line argument where the missing event occurred first
      */
-    Derived&
-    if_missing(index_action a) {
-        missingActions_.push_back(std::move(a));
-        return *static_cast<Derived*>(this);
+    template<class Action>
+    if_index_action<Action>
+    if_missing(Action&& a) {
+        return add<action_kind::missing>(std::forward<Action>(a));
     }
 
 
     //---------------------------------------------------------------
-    /** @brief adds an action that will be called if a parameter
-     *         was matched, but was unreachable in the current scope
-     */
-    Derived&
-    if_blocked(simple_action a) {
-        blockedActions_.push_back(simple_action_adapter{std::move(a)});
-        return *static_cast<Derived*>(this);
-    }
     /** @brief adds an action that will be called if a parameter
      *         was matched, but was unreachable in the current scope;
-     *         the action will be called with the index of
-     *         the command line argument where the problem occurred
+     *         the action may take the index of the command line argument
+     *         where the problem occurred
      */
-    Derived&
-    if_blocked(index_action a) {
-        blockedActions_.push_back(std::move(a));
-        return *static_cast<Derived*>(this);
+    template<class Action>
+    if_index_action<Action>
+    if_blocked(Action&& a) {
+        return add<action_kind::blocked>(std::forward<Action>(a));
     }
 
 
     //---------------------------------------------------------------
-    /** @brief adds an action that will be called if a parameter match
-     *         was in conflict with a different alternative parameter
-     */
-    Derived&
-    if_conflicted(simple_action a) {
-        conflictActions_.push_back(simple_action_adapter{std::move(a)});
-        return *static_cast<Derived*>(this);
-    }
     /** @brief adds an action that will be called if a parameter match
      *         was in conflict with a different alternative parameter;
-     *         the action will be called with the index of
-     *         the command line argument where the problem occurred
+     *         the action may take the index of the command line argument
+     *         where the problem occurred
      */
-    Derived&
-    if_conflicted(index_action a) {
-        conflictActions_.push_back(std::move(a));
-        return *static_cast<Derived*>(this);
+    template<class Action>
+    if_index_action<Action>
+    if_conflicted(Action&& a) {
+        return add<action_kind::conflicted>(std::forward<Action>(a));
     }
 
 
@@ -1406,37 +2414,71 @@ public:
     //---------------------------------------------------------------
     /** @brief executes all argument actions */
     void execute_actions(const arg_string& arg) const {
-        int i = 0;
-        for(const auto& a : argActions_) {
-            ++i;
-            a(arg.c_str());
+        for(const auto& a : actions_) {
+            if(a.kind() == action_kind::arg) a(arg.c_str());
+        }
+    }
+
+    /** @brief executes all argument actions; number targets are set from
+     *         'num' (if possible) instead of converting 'arg' again */
+    void execute_actions(const arg_string& arg,
+                         const scanned_number& num) const
+    {
+        if(!num) return execute_actions(arg);
+        for(const auto& a : actions_) {
+            if(a.kind() == action_kind::arg && !a(num)) a(arg.c_str());
+        }
+    }
+
+    /** @brief true, if some targets are containers that can make room
+     *         for values before they are appended one by one */
+    bool reserves_targets() const noexcept {
+        for(const auto& a : actions_) {
+            if(a.reserves_targets()) return true;
         }
+        return false;
+    }
+    /** @brief makes container targets reserve space for 'n' more values */
+    void reserve_targets(std::size_t n) const {
+        for(const auto& a : actions_) a.reserve_targets(n);
     }
 
     /** @brief executes repeat actions */
     void notify_repeated(arg_index idx) const {
-        for(const auto& a : repeatActions_) a(idx);
+        notify(action_kind::repeated, idx);
     }
     /** @brief executes missing error actions */
     void notify_missing(arg_index idx) const {
-        for(const auto& a : missingActions_) a(idx);
+        notify(action_kind::missing, idx);
     }
     /** @brief executes blocked error actions */
     void notify_blocked(arg_index idx) const {
-        for(const auto& a : blockedActions_) a(idx);
+        notify(action_kind::blocked, idx);
     }
     /** @brief executes conflict error actions */
     void notify_conflict(arg_index idx) const {
-        for(const auto& a : conflictActions_) a(idx);
+        notify(action_kind::conflicted, idx);
     }
 
 private:
     //---------------------------------------------------------------
-    std::vector<arg_action> argActions_;
-    std::vector<index_action> repeatActions_;
-    std::vector<index_action> missingActions_;
-    std::vector<index_action> blockedActions_;
-    std::vector<index_action> conflictActions_;
+    template<action_kind Kind, class Action>
+    Derived&
+    add(Action&& a) {
+        actions_.push_back(param_action::make<Kind>(std::forward<Action>(a)));
+        return *static_cast<Derived*>(this);
+    }
+
+    void notify(action_kind kind, arg_index idx) const {
+        for(const auto& a : actions_) {
+            if(a.kind() == kind) a(idx);
+        }
+    }
+
+    //---------------------------------------------------------------
+    /** @brief all actions in the order in which they were added;
+     *         most parameters have at most two */
+    small_vector<param_action,2> actions_;
 };
 
 
@@ -1570,6 +2612,38 @@ doc(doc_string docstr, token<T>&& p)
 
 
 
+/*************************************************************************//**
+ *
+ * @brief containers for parser state and parsing results;
+ *        with CLIPP_ENABLE_PMR they allocate from a (polymorphic)
+ *        memory resource, otherwise from the global heap
+ *
+ *****************************************************************************/
+#ifdef CLIPP_HAS_PMR
+using memory_resource = std::pmr::memory_resource;
+template<class T> using pooled_vector = std::pmr::vector<T>;
+#else
+class memory_resource;
+template<class T> using pooled_vector = std::vector<T>;
+#endif
+
+/** @brief returns empty vector that allocates from 'res'
+ *         (or from the default resource if 'res' is null)
+ */
+template<class T>
+inline pooled_vector<T>
+make_pooled_vector(memory_resource* res)
+{
+#ifdef CLIPP_HAS_PMR
+    return pooled_vector<T>(res ? res : std::pmr::get_default_resource());
+#else
+    (void)res;
+    return pooled_vector<T>{};
+#endif
+}
+
+
+
 } // namespace detail
 
 
@@ -1639,6 +2713,40 @@ alphabetic(const arg_string& s) {
 
 
 
+/*************************************************************************//**
+ *
+ * @brief predicate that returns true if the argument string is
+ *        equal to any string from a list of values;
+ *        the strings are kept in a hash set
+ *
+ *****************************************************************************/
+class one_of_values
+{
+public:
+    one_of_values(const arg_list& strs):
+        values_{strs.begin(), strs.end()}
+    {}
+
+    template<class... Strings>
+    one_of_values(arg_string str, Strings&&... strs):
+        values_{std::move(str), arg_string(std::forward<Strings>(strs))...}
+    {}
+
+    template<class... Strings>
+    one_of_values(const char* str, Strings&&... strs):
+        values_{arg_string(str), arg_string(std::forward<Strings>(strs))...}
+    {}
+
+    bool operator () (const arg_string& arg) const {
+        return values_.find(arg) != values_.end();
+    }
+
+private:
+    std::unordered_set<arg_string> values_;
+};
+
+
+
 /*************************************************************************//**
  *
  * @brief predicate that returns false if the argument string is
@@ -1648,8 +2756,8 @@ alphabetic(const arg_string& s) {
 class none_of
 {
 public:
-    none_of(arg_list strs):
-        excluded_{std::move(strs)}
+    none_of(const arg_list& strs):
+        excluded_{strs}
     {}
 
     template<class... Strings>
@@ -1663,12 +2771,11 @@ public:
     {}
 
     bool operator () (const arg_string& arg) const {
-        return (std::find(begin(excluded_), end(excluded_), arg)
-                == end(excluded_));
+        return !excluded_(arg);
     }
 
 private:
-    arg_list excluded_;
+    one_of_values excluded_;
 };
 
 
@@ -1693,10 +2800,41 @@ public:
     {}
 
     subrange operator () (const arg_string& s) const {
-        return str::first_number_match(s, separator_, decpoint_, exp_);
+        detail::scanned_number num;
+        return (*this)(s, num);
+    }
+
+    /** @brief same as above; the value of an argument that is a plain
+     *         number (see 'detail::scan_number') is stored in 'num'
+     */
+    subrange operator () (const arg_string& s,
+                          detail::scanned_number& num) const
+    {
+        return match(s.data(), s.data() + s.size(), num);
+    }
+
+    /** @brief same as above for the character range [first,last) */
+    subrange operator () (const char* first, const char* last) const {
+        detail::scanned_number num;
+        return match(first, last, num);
     }
 
 private:
+    subrange match(const char* first, const char* last,
+                   detail::scanned_number& num) const
+    {
+        num = detail::scanned_number{};
+        //plain numbers are matched as a whole and scanned in one pass
+        if(decpoint_ == '.' && (exp_ == 'e' || exp_ == 'E') &&
+           !std::strchr("0123456789+-.eE", separator_) &&
+           detail::scan_number(first, last, true, num))
+        {
+            return subrange{0,std::size_t(last - first)};
+        }
+        return str::first_number_match(first, last,
+                                       separator_, decpoint_, exp_);
+    }
+
     char decpoint_;
     char separator_;
     char exp_;
@@ -1716,10 +2854,39 @@ public:
     integers(char digitSeparator = ' '): separator_{digitSeparator} {}
 
     subrange operator () (const arg_string& s) const {
-        return str::first_integer_match(s, separator_);
+        detail::scanned_number num;
+        return (*this)(s, num);
+    }
+
+    /** @brief same as above; the value of an argument that is a plain
+     *         integer (see 'detail::scan_number') is stored in 'num'
+     */
+    subrange operator () (const arg_string& s,
+                          detail::scanned_number& num) const
+    {
+        return match(s.data(), s.data() + s.size(), num);
+    }
+
+    /** @brief same as above for the character range [first,last) */
+    subrange operator () (const char* first, const char* last) const {
+        detail::scanned_number num;
+        return match(first, last, num);
     }
 
 private:
+    subrange match(const char* first, const char* last,
+                   detail::scanned_number& num) const
+    {
+        num = detail::scanned_number{};
+        //plain integers are matched as a whole and scanned in one pass
+        if(!std::strchr("0123456789+-", separator_) &&
+           detail::scan_number(first, last, false, num))
+        {
+            return subrange{0,std::size_t(last - first)};
+        }
+        return str::first_integer_match(first, last, separator_);
+    }
+
     char separator_;
 };
 
@@ -1737,9 +2904,14 @@ public:
     positive_integers(char digitSeparator = ' '): separator_{digitSeparator} {}
 
     subrange operator () (const arg_string& s) const {
-        auto match = str::first_integer_match(s, separator_);
+        return (*this)(s.data(), s.data() + s.size());
+    }
+
+    /** @brief same as above for the character range [first,last) */
+    subrange operator () (const char* first, const char* last) const {
+        auto match = str::first_integer_match(first, last, separator_);
         if(!match) return subrange{};
-        if(s[match.at()] == '-') return subrange{};
+        if(first[match.at()] == '-') return subrange{};
         return match;
     }
 
@@ -1783,7 +2955,7 @@ public:
     prefix(arg_string p): prefix_{std::move(p)} {}
 
     bool operator () (const arg_string& s) const {
-        return s.find(prefix_) == 0;
+        return s.compare(0, prefix_.size(), prefix_) == 0;
     }
 
 private:
@@ -1804,7 +2976,7 @@ public:
     prefix_not(arg_string p): prefix_{std::move(p)} {}
 
     bool operator () (const arg_string& s) const {
-        return s.find(prefix_) != 0;
+        return s.compare(0, prefix_.size(), prefix_) != 0;
     }
 
 private:
@@ -1883,26 +3055,32 @@ class parameter :
     public detail::token<parameter>,
     public detail::action_provider<parameter>
 {
-    /** @brief adapts a 'match_predicate' to the 'match_function' interface */
+    /** @brief adapts a predicate (arg_string -> bool) to a match
+     *         operation (arg_string -> subrange); the predicate is stored
+     *         by value so that it is type-erased only once
+     */
+    template<class Predicate>
     class predicate_adapter {
     public:
         explicit
-        predicate_adapter(match_predicate pred): match_{std::move(pred)} {}
+        predicate_adapter(Predicate pred): match_(std::move(pred)) {}
 
         subrange operator () (const arg_string& arg) const {
             return match_(arg) ? subrange{0,arg.size()} : subrange{};
         }
 
     private:
-        match_predicate match_;
+        Predicate match_;
     };
 
+    using none_adapter = predicate_adapter<bool(*)(const arg_string&)>;
+
 public:
     //---------------------------------------------------------------
     /** @brief makes default parameter, that will match nothing */
     parameter():
         flags_{},
-        matcher_{predicate_adapter{match::none}},
+        matcher_{none_adapter{match::none}},
         label_{}, required_{false}, greedy_{false}
     {}
 
@@ -1911,7 +3089,7 @@ public:
     explicit
     parameter(arg_string str, Strings&&... strs):
         flags_{},
-        matcher_{predicate_adapter{match::none}},
+        matcher_{none_adapter{match::none}},
         label_{}, required_{false}, greedy_{false}
     {
         add_flags(std::move(str), std::forward<Strings>(strs)...);
@@ -1921,7 +3099,7 @@ public:
     explicit
     parameter(const arg_list& flaglist):
         flags_{},
-        matcher_{predicate_adapter{match::none}},
+        matcher_{none_adapter{match::none}},
         label_{}, required_{false}, greedy_{false}
     {
         add_flags(flaglist);
@@ -1934,7 +3112,21 @@ public:
     explicit
     parameter(match_predicate filter):
         flags_{},
-        matcher_{predicate_adapter{std::move(filter)}},
+        matcher_{predicate_adapter<match_predicate>{std::move(filter)}},
+        label_{}, required_{false}, greedy_{false}
+    {}
+
+    /** @brief makes "value" parameter with custom match predicate
+     *         (= yes/no matcher) that is stored without an extra
+     *         'std::function' wrapper
+     */
+    template<class Predicate, class = typename std::enable_if<
+        traits::is_callable<Predicate,bool(const arg_string&)>::value>::type>
+    explicit
+    parameter(Predicate&& filter):
+        flags_{},
+        matcher_{predicate_adapter<typename std::decay<Predicate>::type>{
+                 std::forward<Predicate>(filter)}},
         label_{}, required_{false}, greedy_{false}
     {}
 
@@ -1948,6 +3140,43 @@ public:
         label_{}, required_{false}, greedy_{false}
     {}
 
+    /** @brief makes "value" parameter with custom match function
+     *         (= partial matcher) that is stored without an extra
+     *         'std::function' wrapper; if it can also be called with a
+     *         character range [first,last), parts of joined arguments
+     *         are matched in place
+     */
+    template<class Matcher, typename std::enable_if<
+        traits::is_callable<Matcher,subrange(const arg_string&)>::value &&
+        !std::is_same<typename std::decay<Matcher>::type,
+                      match_function>::value,int>::type = 0>
+    explicit
+    parameter(Matcher&& filter):
+        flags_{},
+        matcher_{std::forward<Matcher>(filter)},
+        label_{}, required_{false}, greedy_{false}
+    {}
+
+    /** @brief makes "value" parameter that matches numbers;
+     *         arguments are validated and converted in one pass
+     */
+    explicit
+    parameter(const match::numbers& filter):
+        flags_{},
+        matcher_{filter},
+        label_{}, required_{false}, greedy_{false}
+    {}
+
+    /** @brief makes "value" parameter that matches integers;
+     *         arguments are validated and converted in one pass
+     */
+    explicit
+    parameter(const match::integers& filter):
+        flags_{},
+        matcher_{filter},
+        label_{}, required_{false}, greedy_{false}
+    {}
+
 
     //---------------------------------------------------------------
     /** @brief returns if a parameter is required */
@@ -2028,6 +3257,40 @@ public:
         }
     }
 
+    /** @brief same as 'match(arg)'; numbers are also scanned into 'num'
+     *         (if the parameter was made from 'match::numbers' or
+     *         'match::integers')
+     */
+    subrange
+    match(const arg_string& arg, detail::scanned_number& num) const
+    {
+        if(flags_.empty()) return matcher_(arg, num);
+        num = detail::scanned_number{};
+        return match(arg);
+    }
+
+    /** @brief same as 'match(arg.substr(at))', but flags and match
+     *         operations that accept character ranges are applied in place;
+     *         the result is relative to position 'at'
+     */
+    subrange
+    match(const arg_string& arg, arg_string::size_type at) const
+    {
+        if(at == 0) return match(arg);
+        if(flags_.empty()) return matcher_(arg, at);
+
+        //empty flags are not allowed
+        if(at >= arg.size()) return subrange{};
+
+        auto n = arg_string::size_type(0);
+        for(const auto& f : flags_) {
+            if(f.size() > n && arg.compare(at, f.size(), f) == 0) {
+                n = f.size();
+            }
+        }
+        return n > 0 ? subrange{0,n} : subrange{};
+    }
+
 
     //---------------------------------------------------------------
     /** @brief access range of flag strings */
@@ -2036,10 +3299,10 @@ public:
         return flags_;
     }
 
-    /** @brief access custom match operation */
-    const match_function&
-    matcher() const noexcept {
-        return matcher_;
+    /** @brief returns copy of custom match operation */
+    match_function
+    matcher() const {
+        return match_function{matcher_};
     }
 
 
@@ -2142,7 +3405,7 @@ private:
     }
 
     arg_list flags_;
-    match_function matcher_;
+    detail::param_matcher matcher_;
     doc_string label_;
     bool required_ = false;
     bool greedy_ = false;
@@ -2802,7 +4065,7 @@ public:
             const_iterator cur;
             const_iterator end;
         };
-        using context_list = std::vector<context>;
+        using context_list = detail::small_vector<context,8>;
 
         //-----------------------------------------------------
         class memento {
@@ -4055,77 +5318,1083 @@ namespace detail {
 
 /*************************************************************************//**
  *
- * @brief DFS traverser that keeps track of 'scopes'
- *        scope = all parameters that are either bounded by
- *        two blocking parameters on the same depth level
- *        or the beginning/end of the outermost group
+ * @brief set of boolean flags indexed by traversal depth level;
+ *        the first 64 levels are stored inline
  *
  *****************************************************************************/
-class scoped_dfs_traverser
+class level_flags
 {
 public:
-    using dfs_traverser = group::depth_first_traverser;
-
-    scoped_dfs_traverser() = default;
-
-    explicit
-    scoped_dfs_traverser(const group& g):
-        pos_{g}, lastMatch_{}, posAfterLastMatch_{}, scopes_{},
-        ignoreBlocks_{false},
-        repeatGroupStarted_{false}, repeatGroupContinues_{false}
-    {}
-
-    const dfs_traverser& base() const noexcept { return pos_; }
-    const dfs_traverser& last_match() const noexcept { return lastMatch_; }
-
-    const group& parent() const noexcept { return pos_.parent(); }
-
-    const group* innermost_repeat_group() const noexcept {
-        return pos_.innermost_repeat_group();
-    }
-    const group* outermost_join_group() const noexcept {
-        return pos_.outermost_join_group();
-    }
-    const group* innermost_blocking_group() const noexcept {
-        return pos_.innermost_blocking_group();
+    bool test(int level) const noexcept {
+        if(level < 64) return ((bits_ >> level) & 1u) != 0;
+        const auto i = std::size_t(level - 64);
+        return i < more_.size() && more_[i];
     }
-    const group* innermost_exclusive_group() const noexcept {
-        return pos_.innermost_exclusive_group();
-    }
-
-    const pattern* operator ->() const noexcept { return pos_.operator->(); }
-    const pattern& operator *() const noexcept { return *pos_; }
-
-    const pattern* ptr() const noexcept { return pos_.operator->(); }
 
-    explicit operator bool() const noexcept { return bool(pos_); }
+    void set(int level) {
+        if(level < 64) {
+            bits_ |= (std::uint64_t(1) << level);
+        } else {
+            const auto i = std::size_t(level - 64);
+            if(i >= more_.size()) more_.resize(i + 1, false);
+            more_[i] = true;
+        }
+    }
 
-    bool joinable() const noexcept { return pos_.joinable(); }
-    arg_string common_flag_prefix() const { return pos_.common_flag_prefix(); }
+    void reset(int level) noexcept {
+        if(level < 64) {
+            bits_ &= ~(std::uint64_t(1) << level);
+        } else {
+            const auto i = std::size_t(level - 64);
+            if(i < more_.size()) more_[i] = false;
+        }
+    }
 
-    void ignore_blocking(bool yes) { ignoreBlocks_ = yes; }
+    /** @brief resets flags of all levels >= 'level' */
+    void reset_from(int level) noexcept {
+        if(level < 64) {
+            bits_ &= (std::uint64_t(1) << level) - 1;
+            more_.clear();
+        } else {
+            const auto i = std::size_t(level - 64);
+            if(i < more_.size()) more_.erase(more_.begin() + i, more_.end());
+        }
+    }
 
-    void invalidate() {
-        pos_.invalidate();
+    void clear() noexcept {
+        bits_ = 0;
+        more_.clear();
     }
 
-    bool matched() const noexcept {
-        return (pos_ == lastMatch_);
+    bool none() const noexcept {
+        return bits_ == 0 &&
+            std::find(more_.begin(), more_.end(), true) == more_.end();
     }
 
-    bool start_of_repeat_group() const noexcept { return repeatGroupStarted_; }
+private:
+    std::uint64_t bits_ = 0;
+    std::vector<bool> more_;
+};
 
-    //-----------------------------------------------------
-    scoped_dfs_traverser&
-    next_sibling() { pos_.next_sibling(); return *this; }
 
-    scoped_dfs_traverser&
-    next_after_siblings() { pos_.next_after_siblings(); return *this; }
 
 
-    //-----------------------------------------------------
-    scoped_dfs_traverser&
-    operator ++ ()
+/*************************************************************************//**
+ *
+ * @brief node of a flattened (pre-order) command line interface tree;
+ *        caches the properties of the pattern it refers to
+ *
+ *****************************************************************************/
+class cli_node
+{
+    friend class cli_table;
+
+public:
+    bool is_param() const noexcept { return !group_; }
+    bool is_group() const noexcept { return group_; }
+
+    const parameter& as_param() const noexcept { return pat_->as_param(); }
+    const group& as_group() const noexcept { return *grp_; }
+
+    /** @brief nullptr for the root node */
+    const pattern* pat() const noexcept { return pat_; }
+
+    bool blocking()   const noexcept { return blocking_; }
+    bool repeatable() const noexcept { return repeatable_; }
+    bool required()   const noexcept { return required_; }
+    bool exclusive()  const noexcept { return exclusive_; }
+    bool joinable()   const noexcept { return joinable_; }
+
+    /** @brief index of parent node; -1 for the root node */
+    int parent() const noexcept { return parent_; }
+    /** @brief index of next sibling or one past the parent's subtree */
+    int next()   const noexcept { return next_; }
+    /** @brief one past the index of the last node in this node's subtree */
+    int end()    const noexcept { return end_; }
+    /** @brief number of ancestors */
+    int depth()  const noexcept { return depth_; }
+    /** @brief index of last child; -1 for parameters and empty groups */
+    int last_child() const noexcept { return lastChild_; }
+
+    /** @brief true, if node is the last child of its parent */
+    bool last_in_parent() const noexcept { return last_; }
+
+    /** @brief true, if this node and all its ancestors below depth
+     *         'rootDepth' are the last children of their parents */
+    bool last_in_path(int rootDepth) const noexcept {
+        return lastFrom_ <= rootDepth;
+    }
+
+    /** @brief summary of this node's subtree (including the node itself):
+     *         contains blocking nodes */
+    bool has_blocking() const noexcept { return hasBlocking_; }
+    /** @brief contains repeatable, non-empty groups */
+    bool has_repeat_groups() const noexcept { return hasRepeatGroups_; }
+
+    /** @brief true, if this is a group of alternatives that all start with
+     *         a blocking flag parameter (e.g. a choice between commands);
+     *         alternatives may also be such (nested) choices themselves */
+    bool dispatches() const noexcept { return dispatches_; }
+
+private:
+    const pattern* pat_ = nullptr;
+    const group* grp_ = nullptr;
+    int parent_ = -1;
+    int next_ = 0;
+    int end_ = 0;
+    int depth_ = 0;
+    int lastFrom_ = 0;
+    bool group_ = false;
+    bool blocking_ = false;
+    bool repeatable_ = false;
+    bool required_ = false;
+    bool exclusive_ = false;
+    bool joinable_ = false;
+    bool last_ = false;
+    bool hasBlocking_ = false;
+    bool hasRepeatGroups_ = false;
+    bool dispatches_ = false;
+    int lastChild_ = -1;
+    int join_ = -1;
+};
+
+
+
+
+/*************************************************************************//**
+ *
+ * @brief immutable, contiguous pre-order table of all nodes of a
+ *        command line interface; node 0 is the root group
+ *
+ *****************************************************************************/
+class cli_table
+{
+public:
+    using size_type = std::vector<cli_node>::size_type;
+
+    explicit
+    cli_table(const group& root): nodes_{}
+    {
+        cli_node n;
+        n.grp_ = &root;
+        n.group_ = true;
+        n.blocking_ = root.blocking();
+        n.repeatable_ = root.repeatable();
+        n.required_ = (root.exclusive() && root.all_required()) ||
+                     (!root.exclusive() && root.any_required());
+        n.exclusive_ = root.exclusive();
+        n.joinable_ = root.joinable();
+        n.last_ = true;
+        nodes_.push_back(n);
+        if(n.joinable_) joinNodes_.push_back(0);
+
+        add_children(root, 0);
+        nodes_.front().end_ = int(nodes_.size());
+        nodes_.front().next_ = int(nodes_.size());
+        index_trie();
+
+        for(int i = 1; i < int(nodes_.size()); ++i) {
+            auto& c = nodes_[size_type(i)];
+            c.lastFrom_ = c.last_ ? nodes_[c.parent_].lastFrom_ : c.depth_;
+            if(c.last_) nodes_[size_type(c.parent_)].lastChild_ = i;
+        }
+
+        //subtree summaries (children come after their parents)
+        for(auto i = nodes_.size(); i > 0; --i) {
+            auto& c = nodes_[i-1];
+            c.hasBlocking_ |= c.blocking_;
+            c.hasRepeatGroups_ |= c.group_ && c.repeatable_ && c.end_ > int(i);
+            if(c.parent_ >= 0) {
+                auto& p = nodes_[size_type(c.parent_)];
+                p.hasBlocking_ |= c.hasBlocking_;
+                p.hasRepeatGroups_ |= c.hasRepeatGroups_;
+            }
+        }
+
+        for(int g : joinNodes_) {
+            nodes_[size_type(g)].join_ = int(joinInfos_.size());
+            joinInfos_.push_back(make_join_info(g));
+        }
+
+        //choices between commands (nested ones first)
+        for(int i = int(nodes_.size()) - 1; i >= 0; --i) {
+            auto& g = nodes_[size_type(i)];
+            if(!g.exclusive_ || g.lastChild_ < 0) continue;
+            g.dispatches_ = true;
+            for(int c = i + 1; c < g.end_; c = nodes_[size_type(c)].next_) {
+                if(!starts_with_command(c)) {
+                    g.dispatches_ = false;
+                    break;
+                }
+            }
+        }
+    }
+
+    const group& root() const noexcept { return *nodes_.front().grp_; }
+
+    size_type size() const noexcept { return nodes_.size(); }
+
+    const cli_node& operator [] (int i) const noexcept {
+        return nodes_[size_type(i)];
+    }
+
+    /** @brief true, if node 'i' is a (strict) descendant of node 'anc' */
+    bool inside(int i, int anc) const noexcept {
+        return anc < i && i < nodes_[size_type(anc)].end_;
+    }
+
+    /** @brief true, if node 'i' is 'n' or one of its descendants */
+    bool inside_or_self(int i, int n) const noexcept {
+        return n <= i && i < nodes_[size_type(n)].end_;
+    }
+
+    /** @brief child of group 'g' that is node 'i' or contains it */
+    int child_containing(int i, int g) const noexcept {
+        while(nodes_[size_type(i)].parent_ != g) i = nodes_[size_type(i)].parent_;
+        return i;
+    }
+
+    /** @brief alternative of command choice 'g' (see cli_node::dispatches)
+     *         in which a traversal visits node 'i'; -1 if there is none
+     */
+    int visited_alternative(int i, int g) const noexcept {
+        int alt = i;
+        int parent = nodes_[size_type(i)].parent_;
+        if(!nodes_[size_type(parent)].dispatches_) {
+            //must be the command starting a non-exclusive alternative
+            if(nodes_[size_type(i)].group_ || i != parent + 1) return -1;
+            alt = parent;
+            parent = nodes_[size_type(alt)].parent_;
+        }
+        while(parent != g) {
+            if(parent < g || !nodes_[size_type(parent)].dispatches_) return -1;
+            alt = parent;
+            parent = nodes_[size_type(alt)].parent_;
+        }
+        return alt;
+    }
+
+    /** @brief flag prefix and single-character flags of a joinable group */
+    struct join_info {
+        /** @brief common flag prefix of the group */
+        arg_string prefix;
+        /** @brief parameter node with flag 'prefix + c' for each character
+         *         c (or -1); empty, unless all flags in the group consist
+         *         of 'prefix' and one character that identifies the flag's
+         *         parameter */
+        std::vector<int> shortFlags;
+    };
+
+    /** @brief flag info of joinable group node 'g' */
+    const join_info& join_info_of(int g) const noexcept {
+        return joinInfos_[size_type(nodes_[size_type(g)].join_)];
+    }
+
+    /** @brief sorted indices of all parameter nodes without flags */
+    const std::vector<int>& value_nodes() const noexcept { return valueNodes_; }
+
+    /** @brief sorted indices of all joinable group nodes */
+    const std::vector<int>& joinable_nodes() const noexcept { return joinNodes_; }
+
+    /** @brief length of the longest flag of any parameter */
+    arg_string::size_type max_flag_length() const noexcept {
+        return maxFlagLength_;
+    }
+
+    /** @brief returns sorted indices of all parameter nodes that have
+     *         'flag' as one of their flags; nullptr if there are none */
+    const std::vector<int>*
+    flag_candidates(const arg_string& flag) const {
+        const auto i = flagIndex_.find(flag);
+        return i != flagIndex_.end() ? &(trie_[size_type(i->second)].params)
+                                     : nullptr;
+    }
+
+    //-----------------------------------------------------
+    /** @brief flag that is a prefix of an argument */
+    struct flag_prefix {
+        arg_string::size_type length;
+        /** @brief sorted indices of parameter nodes having that flag */
+        const std::vector<int>* params;
+    };
+
+    /** @brief flag prefixes of one argument; there are rarely more than
+     *         a few, so they are usually stored without heap allocation */
+    using flag_prefix_list = small_vector<flag_prefix,8>;
+
+    /** @brief returns all flags (of any parameter) that are prefixes of
+     *         'arg' from position 'at' on in order of increasing length;
+     *         runs in O(longest flag) by following 'arg' through a trie */
+    flag_prefix_list
+    flag_prefixes(const arg_string& arg, arg_string::size_type at = 0) const
+    {
+        flag_prefix_list res;
+        int t = 0;
+        for(arg_string::size_type i = at; i < arg.size(); ++i) {
+            t = trie_child(t, arg[i]);
+            if(t < 0) break;
+            const auto& params = trie_[size_type(t)].params;
+            if(!params.empty()) res.push_back(flag_prefix{i+1-at, &params});
+        }
+        return res;
+    }
+
+private:
+    /** @brief true, if a traversal that enters alternative 'c' only visits
+     *         blocking flag parameters and leaves 'c' if none of them match:
+     *         a command, a group starting with a command or a command choice
+     */
+    bool starts_with_command(int c) const noexcept {
+        const auto is_command = [this](int i) {
+            const auto& n = nodes_[size_type(i)];
+            return n.is_param() && n.blocking_ && !n.as_param().flags().empty();
+        };
+        const auto& n = nodes_[size_type(c)];
+        if(n.is_param()) return is_command(c);
+        if(n.repeatable_) return false;
+        if(n.exclusive_) return n.dispatches_ && !n.blocking_;
+        return n.end_ > c + 1 && is_command(c + 1) &&
+               !nodes_[size_type(c + 1)].last_;
+    }
+
+    join_info make_join_info(int g) const
+    {
+        join_info info;
+        info.prefix = nodes_[size_type(g)].as_group().common_flag_prefix();
+
+        const auto n = info.prefix.size();
+        std::vector<int> params(256, -1);
+        for(int i = g + 1; i < nodes_[size_type(g)].end_; ++i) {
+            const auto& node = nodes_[size_type(i)];
+            if(node.group_) continue;
+            for(const auto& f : node.as_param().flags()) {
+                if(f.size() != n + 1 || f.compare(0, n, info.prefix) != 0) {
+                    return info;
+                }
+                auto& p = params[static_cast<unsigned char>(f.back())];
+                if(p >= 0 && p != i) return info;
+                p = i;
+            }
+        }
+        info.shortFlags = std::move(params);
+        return info;
+    }
+
+    void add_children(const group& g, int parentIdx)
+    {
+        int prev = -1;
+        for(const auto& c : g) {
+            const int idx = int(nodes_.size());
+            if(prev >= 0) nodes_[size_type(prev)].next_ = idx;
+            prev = idx;
+
+            cli_node n;
+            n.pat_ = &c;
+            n.grp_ = c.is_group() ? &c.as_group() : nullptr;
+            n.parent_ = parentIdx;
+            n.depth_ = nodes_[size_type(parentIdx)].depth_ + 1;
+            n.group_ = c.is_group();
+            n.blocking_ = c.blocking();
+            n.repeatable_ = c.repeatable();
+            n.required_ = c.required();
+            n.exclusive_ = c.exclusive();
+            n.joinable_ = c.is_group() && c.as_group().joinable();
+            nodes_.push_back(n);
+
+            if(c.is_param()) {
+                if(c.as_param().flags().empty()) valueNodes_.push_back(idx);
+                for(const auto& f : c.as_param().flags()) {
+                    const int t = add_flag(f);
+                    auto& cands = trie_[size_type(t)].params;
+                    if(cands.empty() || cands.back() != idx) cands.push_back(idx);
+                }
+            }
+            else {
+                if(n.joinable_) joinNodes_.push_back(idx);
+                add_children(c.as_group(), idx);
+            }
+            nodes_[size_type(idx)].end_ = int(nodes_.size());
+        }
+        if(prev >= 0) {
+            nodes_[size_type(prev)].next_ = int(nodes_.size());
+            nodes_[size_type(prev)].last_ = true;
+        }
+    }
+
+    /** @brief inserts flag into trie (if not present);
+     *         returns index of the flag's trie node */
+    int add_flag(const arg_string& flag)
+    {
+        const auto i = flagIndex_.find(flag);
+        if(i != flagIndex_.end()) return i->second;
+
+        if(trie_.empty()) trie_.emplace_back();
+        int t = 0;
+        for(const auto c : flag) {
+            int child = trie_[size_type(t)].child;
+            while(child >= 0 && trie_[size_type(child)].c != c) {
+                child = trie_[size_type(child)].sibling;
+            }
+            if(child < 0) {
+                child = int(trie_.size());
+                trie_node n;
+                n.c = c;
+                n.sibling = trie_[size_type(t)].child;
+                trie_[size_type(t)].child = child;
+                trie_.push_back(std::move(n));
+            }
+            t = child;
+        }
+        flagIndex_.emplace(flag, t);
+        maxFlagLength_ = std::max(maxFlagLength_, flag.size());
+        return t;
+    }
+
+    /** @brief stores the children of each trie node as contiguous range
+     *         of edges sorted by character */
+    void index_trie()
+    {
+        trieEdges_.reserve(trie_.size());
+        for(auto& n : trie_) {
+            n.edges = int(trieEdges_.size());
+            for(int i = n.child; i >= 0; i = trie_[size_type(i)].sibling) {
+                trieEdges_.push_back(trie_edge{trie_[size_type(i)].c, i});
+            }
+            n.edgesEnd = int(trieEdges_.size());
+            std::sort(trieEdges_.begin() + n.edges, trieEdges_.end(),
+                [](const trie_edge& a, const trie_edge& b) { return a.c < b.c; });
+        }
+    }
+
+    int trie_child(int t, arg_string::value_type c) const noexcept {
+        if(trie_.empty()) return -1;
+        const auto& n = trie_[size_type(t)];
+        const auto last = trieEdges_.begin() + n.edgesEnd;
+        const auto i = std::lower_bound(trieEdges_.begin() + n.edges, last, c,
+            [](const trie_edge& e, arg_string::value_type x) { return e.c < x; });
+        return (i != last && i->c == c) ? i->node : -1;
+    }
+
+    struct trie_node {
+        arg_string::value_type c = 0;
+        //first child & next sibling; only used while building the trie
+        int child = -1;
+        int sibling = -1;
+        //range of children in 'trieEdges_'
+        int edges = 0;
+        int edgesEnd = 0;
+        std::vector<int> params;
+    };
+
+    struct trie_edge {
+        arg_string::value_type c;
+        int node;
+    };
+
+    std::vector<cli_node> nodes_;
+    //byte trie over all flags; node 0 is the (empty) root
+    std::vector<trie_node> trie_;
+    std::vector<trie_edge> trieEdges_;
+    //flag string -> trie node
+    std::unordered_map<arg_string,int> flagIndex_;
+    arg_string::size_type maxFlagLength_ = 0;
+    //sorted indices of parameters without flags / of joinable groups
+    std::vector<int> valueNodes_;
+    std::vector<int> joinNodes_;
+    std::vector<join_info> joinInfos_;
+};
+
+
+
+
+/*************************************************************************//**
+ *
+ * @brief depth first traverser over the nodes of a 'cli_table';
+ *        the position is a node index, the traversal path is given by
+ *        the table's parent links, so copies don't allocate
+ *
+ *        Going back to a memento ('undo') only replaces the position on the
+ *        memento's level; the path below that level is kept, even if the
+ *        memento's node isn't located there. Such levels are recorded as
+ *        'splices': leaving a spliced level goes back to the kept node
+ *        instead of the node's parent.
+ *
+ *****************************************************************************/
+class cli_traverser
+{
+public:
+    //-----------------------------------------------------
+    class memento {
+        friend class cli_traverser;
+        int level_ = 0;
+        int root_ = 0;
+        int cur_ = -1;
+        bool restricted_ = false;
+    public:
+        int level() const noexcept { return level_; }
+        int node() const noexcept { return cur_; }
+        int root() const noexcept { return root_; }
+
+        friend bool operator == (const memento& a, const memento& b) noexcept {
+            return a.level_ == b.level_ && a.root_ == b.root_ &&
+                   a.cur_ == b.cur_ && a.restricted_ == b.restricted_;
+        }
+    };
+
+    cli_traverser() = default;
+
+    explicit
+    cli_traverser(const cli_table& t, int root = 0):
+        t_{&t}, root_{root}, cur_{-1}, restricted_{}, splices_{}
+    {
+        if(t[root].end() > root + 1) cur_ = root + 1;
+    }
+
+    explicit operator bool() const noexcept {
+        return cur_ >= 0;
+    }
+
+    const cli_table* table() const noexcept { return t_; }
+
+    /** @brief index of current node; -1 if invalid */
+    int node() const noexcept { return cur_; }
+
+    /** @brief index of root node; -1 if invalid */
+    int root() const noexcept { return cur_ >= 0 ? root_ : -1; }
+
+    /** @brief true, if the path doesn't follow the table's parent links */
+    bool spliced() const noexcept { return !splices_.empty(); }
+
+    int level() const noexcept {
+        if(cur_ < 0) return 0;
+        if(splices_.empty()) {
+            return node_at(cur_).depth() - node_at(root_).depth();
+        }
+        const auto& s = splices_.back();
+        return s.level + node_at(cur_).depth() - s.depth;
+    }
+
+    bool is_first_in_parent() const noexcept {
+        if(cur_ < 0) return false;
+        return cur_ == node_at(cur_).parent() + 1;
+    }
+
+    bool is_last_in_parent() const noexcept {
+        if(cur_ < 0) return false;
+        return restricted_.test(level()) || node_at(cur_).last_in_parent();
+    }
+
+    bool is_last_in_path() const noexcept {
+        if(cur_ < 0) return false;
+        //if we have to descend into group on next ++ => not last in path
+        if(node_at(cur_).is_group()) return false;
+        if(splices_.empty()) {
+            const auto rootDepth = node_at(root_).depth();
+            if(node_at(cur_).last_in_path(rootDepth)) return true;
+            if(restricted_.none()) return false;
+        }
+        return !walk_path([this](int i, int l) {
+            return !restricted_.test(l) && !node_at(i).last_in_parent(); });
+    }
+
+    /** @brief inside a group of alternatives >= minlevel */
+    bool is_alternative(int minlevel = 0) const noexcept {
+        if(minlevel > 0) minlevel -= 1;
+        return walk_path([&](int i, int l) {
+            return l > minlevel && node_at(node_at(i).parent()).exclusive(); });
+    }
+
+    /** @brief repeatable or inside a repeatable group >= minlevel */
+    bool is_repeatable(int minlevel = 0) const noexcept {
+        if(cur_ < 0) return false;
+        if(node_at(cur_).repeatable()) return true;
+        if(minlevel > 0) minlevel -= 1;
+        return walk_path([&](int i, int l) {
+            return l > minlevel && node_at(node_at(i).parent()).repeatable(); });
+    }
+
+    /** @brief inside a particular group */
+    bool is_inside(int g) const noexcept {
+        if(cur_ < 0 || g < 0) return false;
+        if(splices_.empty()) return g >= root_ && t_->inside(cur_, g);
+        return walk_path([&](int i, int) { return node_at(i).parent() == g; });
+    }
+
+    /** @brief inside group with joinable flags */
+    bool joinable() const noexcept {
+        return outermost_join_group() >= 0;
+    }
+
+    /** @brief innermost repeat group */
+    int innermost_repeat_group() const noexcept {
+        return innermost_ancestor([](const cli_node& n) {
+            return n.repeatable(); });
+    }
+
+    /** @brief innermost exclusive (alternatives) group */
+    int innermost_exclusive_group() const noexcept {
+        return innermost_ancestor([](const cli_node& n) {
+            return n.exclusive(); });
+    }
+
+    /** @brief innermost blocking group */
+    int innermost_blocking_group() const noexcept {
+        return innermost_ancestor([](const cli_node& n) {
+            return n.blocking(); });
+    }
+
+    /** @brief returns the outermost group that will be left on next ++*/
+    int outermost_blocking_group_fully_explored() const noexcept {
+        int g = -1;
+        walk_path([&](int i, int l) {
+            if(!restricted_.test(l) && !node_at(i).last_in_parent()) return true;
+            if(node_at(node_at(i).parent()).blocking()) g = node_at(i).parent();
+            return false;
+        });
+        return g;
+    }
+
+    /** @brief outermost join group */
+    int outermost_join_group() const noexcept {
+        int g = -1;
+        walk_path([&](int i, int) {
+            if(node_at(node_at(i).parent()).joinable()) g = node_at(i).parent();
+            return false;
+        });
+        return g;
+    }
+
+    /** @brief calls 'f(g, c)' for all groups 'g' on the path (innermost
+     *         first); 'c' is the node on the path inside 'g'
+     */
+    template<class F>
+    void for_each_group_on_path(F&& f) const {
+        walk_path([&](int i, int) {
+            f(node_at(i).parent(), i);
+            return false;
+        });
+    }
+
+    /** @brief common flag prefix of all flags in current group */
+    arg_string common_flag_prefix() const {
+        if(cur_ < 0) return "";
+        auto g = outermost_join_group();
+        return g >= 0 ? node_at(g).as_group().common_flag_prefix()
+                      : arg_string("");
+    }
+
+    const cli_node&
+    operator * () const noexcept {
+        return node_at(cur_);
+    }
+
+    const cli_node*
+    operator -> () const noexcept {
+        return &node_at(cur_);
+    }
+
+    /** @brief index of parent of current node */
+    int parent_node() const noexcept {
+        return node_at(cur_).parent();
+    }
+
+    const cli_node&
+    parent() const noexcept {
+        return node_at(node_at(cur_).parent());
+    }
+
+
+    /** @brief go to next element of depth first search */
+    cli_traverser&
+    operator ++ () {
+        if(cur_ < 0) return *this;
+        //at group -> decend into group
+        if(node_at(cur_).is_group() && node_at(cur_).end() > cur_ + 1) {
+            ++cur_;
+            restricted_.reset(level());
+        }
+        else {
+            next_sibling();
+        }
+        return *this;
+    }
+
+    /** @brief go to next sibling of current */
+    cli_traverser&
+    next_sibling() {
+        while(cur_ >= 0) {
+            if(!restricted_.test(level()) && !node_at(cur_).last_in_parent()) {
+                cur_ = node_at(cur_).next();
+                return *this;
+            }
+            //at the end of current group => go to parent
+            leave_level();
+        }
+        return *this;
+    }
+
+    /** @brief go directly to a later sibling 'n' of current */
+    cli_traverser&
+    skip_to_sibling(int n) noexcept {
+        cur_ = n;
+        return *this;
+    }
+
+    /** @brief go to next position after siblings of current */
+    cli_traverser&
+    next_after_siblings() {
+        if(cur_ < 0) return *this;
+        restricted_.set(level());
+        return next_sibling();
+    }
+
+    /**
+     * @brief go back to the position of ancestor group 'g'
+     */
+    cli_traverser&
+    back_to_ancestor(int g) {
+        if(g < 0) return *this;
+        while(cur_ >= 0) {
+            if(cur_ == g) return *this;
+            leave_level();
+        }
+        return *this;
+    }
+
+    /** @brief don't visit next siblings, go back to parent on next ++
+     *         note: renders siblings unreachable for *this
+     **/
+    cli_traverser&
+    skip_siblings() {
+        if(cur_ < 0) return *this;
+        //future increments won't visit subsequent siblings:
+        restricted_.set(level());
+        return *this;
+    }
+
+    /** @brief skips all other alternatives in surrounding exclusive groups
+     *         on next ++
+     *         note: renders alternatives unreachable for *this
+    */
+    cli_traverser&
+    skip_alternatives() {
+        //exclude all other alternatives in surrounding groups
+        //by making their current position the last one
+        walk_path([this](int i, int l) {
+            if(node_at(node_at(i).parent()).exclusive()) restricted_.set(l);
+            return false;
+        });
+        return *this;
+    }
+
+    void invalidate() {
+        cur_ = -1;
+        restricted_.clear();
+        splices_.clear();
+    }
+
+    inline friend bool operator == (const cli_traverser& a,
+                                    const cli_traverser& b)
+    {
+        if(a.cur_ < 0 || b.cur_ < 0) return false;
+        return a.t_ == b.t_ && a.cur_ == b.cur_;
+    }
+    inline friend bool operator != (const cli_traverser& a,
+                                    const cli_traverser& b)
+    {
+        return !(a == b);
+    }
+
+    memento
+    undo_point() const {
+        memento m;
+        m.level_ = level();
+        m.root_ = root_;
+        m.cur_ = cur_;
+        if(cur_ >= 0) m.restricted_ = restricted_.test(m.level_);
+        return m;
+    }
+
+    void undo(const memento& m) {
+        if(m.level_ < 1) return;
+        if(m.level_ <= level() || (cur_ < 0 && m.level_ == 1)) {
+            //node that stays below the memento's level
+            const int below = m.level_ > 1 ? node_on_level(m.level_ - 1) : -1;
+            while(!splices_.empty() && splices_.back().level >= m.level_) {
+                splices_.pop_back();
+            }
+            restricted_.reset_from(m.level_);
+            if(m.restricted_) restricted_.set(m.level_);
+            if(below >= 0 && below != node_at(m.cur_).parent()) {
+                splices_.push_back(splice{m.level_, below,
+                                          node_at(m.cur_).depth()});
+            }
+            else if(splices_.empty()) {
+                //memento might stem from a traverser with a different root
+                //(positions of joined matches are relative to the join group)
+                root_ = m.root_;
+            }
+            cur_ = m.cur_;
+        }
+    }
+
+private:
+    const cli_node& node_at(int i) const noexcept { return (*t_)[i]; }
+
+    /** @brief calls 'f(node, level)' for the current node and all nodes
+     *         on the path to it (innermost first) until 'f' returns true
+     *  @return true, if 'f' returned true
+     */
+    template<class F>
+    bool walk_path(F&& f) const {
+        if(cur_ < 0) return false;
+        auto s = splices_.size();
+        for(int i = cur_, l = level(); l > 0; --l) {
+            if(f(i, l)) return true;
+            if(s > 0 && splices_[s-1].level == l) {
+                i = splices_[--s].below;
+            } else {
+                i = node_at(i).parent();
+            }
+        }
+        return false;
+    }
+
+    /** @brief node on the path at level 'l' (<= current level) */
+    int node_on_level(int l) const noexcept {
+        int n = -1;
+        walk_path([&](int i, int li) {
+            if(li != l) return false;
+            n = i;
+            return true;
+        });
+        return n;
+    }
+
+    /** @brief goes back to the node on the path below the current one */
+    void leave_level() {
+        const auto l = level();
+        restricted_.reset(l);
+        if(!splices_.empty() && splices_.back().level == l) {
+            cur_ = splices_.back().below;
+            splices_.pop_back();
+        } else {
+            cur_ = node_at(cur_).parent();
+        }
+        if(l <= 1) invalidate();
+    }
+
+    template<class Pred>
+    int innermost_ancestor(Pred&& pred) const noexcept {
+        int g = -1;
+        walk_path([&](int i, int) {
+            if(!pred(node_at(node_at(i).parent()))) return false;
+            g = node_at(i).parent();
+            return true;
+        });
+        return g;
+    }
+
+    /** @brief level whose node isn't a child of the node below it */
+    struct splice {
+        int level;
+        /** @brief node on level 'level-1' */
+        int below;
+        /** @brief table depth of the node on 'level' */
+        int depth;
+    };
+
+    const cli_table* t_ = nullptr;
+    int root_ = 0;
+    int cur_ = -1;
+    level_flags restricted_;
+    small_vector<splice,4> splices_;
+};
+
+
+
+
+/*************************************************************************//**
+ *
+ * @brief DFS traverser that keeps track of 'scopes'
+ *        scope = all parameters that are either bounded by
+ *        two blocking parameters on the same depth level
+ *        or the beginning/end of the outermost group
+ *
+ *****************************************************************************/
+class scoped_dfs_traverser
+{
+public:
+    using dfs_traverser = cli_traverser;
+
+    scoped_dfs_traverser() = default;
+
+    explicit
+    scoped_dfs_traverser(const cli_table& t, int root = 0):
+        pos_{t, root}, lastMatch_{}, posAfterLastMatch_{}, scopes_{},
+        ignoreBlocks_{false},
+        repeatGroupStarted_{false}, repeatGroupContinues_{false}
+    {}
+
+    const dfs_traverser& base() const noexcept { return pos_; }
+    const dfs_traverser& last_match() const noexcept { return lastMatch_; }
+
+    const cli_node& parent() const noexcept { return pos_.parent(); }
+    int parent_node() const noexcept { return pos_.parent_node(); }
+
+    int innermost_repeat_group() const noexcept {
+        return pos_.innermost_repeat_group();
+    }
+    int outermost_join_group() const noexcept {
+        return pos_.outermost_join_group();
+    }
+    int innermost_blocking_group() const noexcept {
+        return pos_.innermost_blocking_group();
+    }
+    int innermost_exclusive_group() const noexcept {
+        return pos_.innermost_exclusive_group();
+    }
+
+    const cli_node* operator ->() const noexcept { return pos_.operator->(); }
+    const cli_node& operator *() const noexcept { return *pos_; }
+
+    const cli_node* ptr() const noexcept { return pos_.operator->(); }
+
+    explicit operator bool() const noexcept { return bool(pos_); }
+
+    bool joinable() const noexcept { return pos_.joinable(); }
+    arg_string common_flag_prefix() const { return pos_.common_flag_prefix(); }
+
+    void ignore_blocking(bool yes) { ignoreBlocks_ = yes; }
+
+    void invalidate() {
+        pos_.invalidate();
+    }
+
+    bool matched() const noexcept {
+        return (pos_ == lastMatch_);
+    }
+
+    bool start_of_repeat_group() const noexcept { return repeatGroupStarted_; }
+
+    /** @brief true, if advancing might lead to nodes outside of the
+     *         subtree of the current root; this is the case if the path
+     *         is spliced or if going back to a scope restores another root
+     *         (positions of joined matches are relative to the join group)
+     */
+    bool may_leave_root() const noexcept {
+        if(pos_.spliced()) return true;
+        return scopes_.any_of([this](const dfs_traverser::memento& s) {
+            return s.root() != pos_.root(); });
+    }
+
+    //-----------------------------------------------------
+    scoped_dfs_traverser&
+    next_sibling() { pos_.next_sibling(); return *this; }
+
+    scoped_dfs_traverser&
+    next_after_siblings() { pos_.next_after_siblings(); return *this; }
+
+    //-----------------------------------------------------
+    /** @brief moves directly to the first sibling (at or after the current
+     *         node) in which ++ would visit a candidate node or to the last
+     *         sibling, if that yields the same state as advancing with ++;
+     *         this is the case for all siblings if blocking is ignored and
+     *         for the alternatives of command choices (see
+     *         cli_node::dispatches);
+     *         'nextCandidate(n)' must return the first candidate node with
+     *         an index >= n (or a value larger than any node index);
+     *         must only be used on positions reached by ++
+     *  @return false, if there are no siblings to skip
+     */
+    template<class NextCandidate>
+    bool skip_to_candidate(NextCandidate&& nextCandidate)
+    {
+        if(!pos_ || pos_.is_last_in_parent() ||
+           pos_.spliced() || lastMatch_.spliced()) return false;
+
+        const cli_table& t = *pos_.table();
+        const int first = pos_.node();
+        const int g = t[first].parent();
+        if(!ignoreBlocks_ && !t[g].dispatches()) return false;
+
+        int target = t[g].last_child();
+        for(int i = nextCandidate(first); i < target; i = nextCandidate(i + 1)) {
+            const int s = ignoreBlocks_ ? t.child_containing(i, g)
+                                        : t.visited_alternative(i, g);
+            if(s >= 0) {
+                target = s;
+                break;
+            }
+        }
+        if(target == first) return false;
+
+        bool leavesRepeatGroup = false;
+        if(ignoreBlocks_) {
+            for(int s = first; s < target; s = t[s].next()) {
+                if(t[s].has_repeat_groups()) leavesRepeatGroup = true;
+            }
+        }
+        else if(lastMatch_ && first <= lastMatch_.node() &&
+                lastMatch_.node() < target)
+        {
+            return false;
+        }
+
+        pos_.skip_to_sibling(target);
+        if(leavesRepeatGroup) repeatGroupContinues_ = false;
+        check_if_left_scope();
+        return true;
+    }
+
+    //-----------------------------------------------------
+    /** @brief moves past the current group in one step if the resulting
+     *         state is the same as after advancing with ++ through it
+     *         and if ++ wouldn't visit any candidate node on the way;
+     *         'nextCandidate(n)' must return the first candidate node with
+     *         an index >= n (or a value larger than any node index);
+     *         must only be used on positions reached by ++
+     *  @return false, if the group can't be skipped
+     */
+    template<class NextCandidate>
+    bool skip_group(NextCandidate&& nextCandidate)
+    {
+        if(!pos_ || !pos_->is_group() || pos_.is_last_in_parent() ||
+           pos_.spliced() || lastMatch_.spliced()) return false;
+
+        const cli_table& t = *pos_.table();
+        const int g = pos_.node();
+        if(lastMatch_ && t.inside(lastMatch_.node(), g)) return false;
+
+        bool leavesRepeatGroup = false;
+        if(ignoreBlocks_ || !t[g].has_blocking()) {
+            //++ visits all nodes of the group
+            if(nextCandidate(g) < t[g].end()) return false;
+            leavesRepeatGroup = t[g].has_repeat_groups();
+        }
+        else {
+            //++ only visits the group node and a leading blocking parameter
+            //(if any) and skips its siblings as long as it doesn't match
+            const int fst = g + 1;
+            if(t[g].exclusive() || t[g].end() <= fst || t[fst].is_group() ||
+               !t[fst].blocking() || t[fst].last_in_parent() ||
+               nextCandidate(g) <= fst)
+            {
+                return false;
+            }
+            leavesRepeatGroup = t[g].repeatable();
+        }
+
+        pos_.next_sibling();
+        if(leavesRepeatGroup) repeatGroupContinues_ = false;
+        check_if_left_scope();
+        return true;
+    }
+
+
+    //-----------------------------------------------------
+    scoped_dfs_traverser&
+    operator ++ ()
     {
         if(!pos_) return *this;
 
@@ -4140,9 +6409,9 @@ public:
         }
         else if(!pos_->is_group()) {
             //current group can block if we didn't have any match in it
-            const group* g = pos_.outermost_blocking_group_fully_explored();
+            const int g = pos_.outermost_blocking_group_fully_explored();
             //no match in 'g' before -> skip to after its siblings
-            if(g && !lastMatch_.is_inside(g)) {
+            if(g >= 0 && !lastMatch_.is_inside(g)) {
                 pos_.back_to_ancestor(g).next_after_siblings();
                 if(!pos_) return_to_outermost_scope();
             }
@@ -4182,9 +6451,10 @@ public:
         //=> current position has to be advanced by one so that it is
         //no longer reachable within current scope
         //(can happen for repeatable, blocking parameters)
-        if(match.base() != pos_ && pos_->blocking()) pos_.next_sibling();
+        if(match.base() != pos_ && pos_ && pos_->blocking()) pos_.next_sibling();
 
-        if(match->blocking()) {
+        //blocking ancestor might be the root => no position left
+        if(match && match->blocking()) {
             if(match.pos_.is_alternative()) {
                 //discard other alternatives
                 match.pos_.skip_alternatives();
@@ -4194,7 +6464,7 @@ public:
                 //if current param is not repeatable -> back to previous scope
                 if(!match->repeatable() && !match->is_group()) {
                     pos_ = std::move(match.pos_);
-                    if(!scopes_.empty()) pos_.undo(scopes_.top());
+                    if(!scopes_.empty()) pos_.undo(scopes_.back());
                 }
                 else { //stay at match position
                     pos_ = std::move(match.pos_);
@@ -4207,7 +6477,7 @@ public:
                 }
 
                 if(match.pos_.level() > pos_.level()) {
-                    scopes_.push(pos_.undo_point());
+                    scopes_.push_back(pos_.undo_point());
                     pos_ = std::move(match.pos_);
                 }
                 else if(match.pos_.level() < pos_.level()) {
@@ -4236,14 +6506,14 @@ private:
         //check if we would leave the current scope on ++
         auto p = pos;
         ++p;
-        return p.level() < scopes_.top().level();
+        return p.level() < scopes_.back().level();
     }
 
     //-----------------------------------------------------
     void check_repeat_group_start(const scoped_dfs_traverser& newMatch)
     {
         const auto newrg = newMatch.innermost_repeat_group();
-        if(!newrg) {
+        if(newrg < 0) {
             repeatGroupStarted_ = false;
         }
         else if(lastMatch_.innermost_repeat_group() != newrg) {
@@ -4259,7 +6529,7 @@ private:
             //conceptually at a position 'before' the group
             repeatGroupStarted_ = scopes_.empty() || (
                     newrg == pos_.root() &&
-                    scopes_.top().param() == &(*pos_.root()->begin()) );
+                    scopes_.back().node() == pos_.root() + 1 );
         }
         repeatGroupContinues_ = repeatGroupStarted_;
     }
@@ -4269,7 +6539,7 @@ private:
     {
         if(!repeatGroupContinues_) return false;
         const auto curRepGroup = pos_.innermost_repeat_group();
-        if(!curRepGroup) return false;
+        if(curRepGroup < 0) return false;
         if(curRepGroup != lastMatch_.innermost_repeat_group()) return false;
         if(!posAfterLastMatch_) return false;
         return true;
@@ -4280,16 +6550,17 @@ private:
     {
         if(posAfterLastMatch_) {
             if(pos_.level() < posAfterLastMatch_.level()) {
-                while(!scopes_.empty() && scopes_.top().level() >= pos_.level()) {
-                    pos_.undo(scopes_.top());
-                    scopes_.pop();
+                while(!scopes_.empty() && scopes_.back().level() >= pos_.level()) {
+                    pos_.undo(scopes_.back());
+                    scopes_.pop_run();
                 }
                 posAfterLastMatch_.invalidate();
             }
         }
-        while(!scopes_.empty() && scopes_.top().level() > pos_.level()) {
-            pos_.undo(scopes_.top());
-            scopes_.pop();
+        while(!scopes_.empty() && scopes_.back().level() > pos_.level()) {
+            pos_.undo(scopes_.back());
+            if(scopes_.back().level() > pos_.level()) scopes_.pop_run();
+            else scopes_.pop_back();
         }
         repeatGroupContinues_ = repeat_group_continues();
     }
@@ -4306,10 +6577,10 @@ private:
         }
 
         while(!scopes_.empty() && (!pos_ || pos_.level() >= 1)) {
-            pos_.undo(scopes_.top());
-            scopes_.pop();
+            pos_.undo(scopes_.back());
+            scopes_.pop_run();
         }
-        while(!scopes_.empty()) scopes_.pop();
+        scopes_.clear();
 
         repeatGroupContinues_ = repeat_group_continues();
     }
@@ -4319,15 +6590,65 @@ private:
     {
         if(pos_.level() <= level) return;
         while(!scopes_.empty() && pos_.level() > level) {
-            pos_.undo(scopes_.top());
-            scopes_.pop();
+            pos_.undo(scopes_.back());
+            if(pos_.level() > level) scopes_.pop_run();
+            else scopes_.pop_back();
+        }
+    };
+
+    /** @brief stack of scope mementos; runs of equal mementos are stored
+     *         as one entry with a count, so that re-entering a scope over
+     *         and over (e.g. in repeat groups) doesn't grow the stack
+     */
+    class scope_stack {
+    public:
+        using memento = dfs_traverser::memento;
+
+        bool empty() const noexcept { return entries_.empty(); }
+
+        /** @brief number of stored (distinct consecutive) mementos */
+        std::size_t depth() const noexcept { return entries_.size(); }
+
+        const memento& back() const noexcept { return entries_.back().m; }
+
+        void push_back(const memento& m) {
+            if(!entries_.empty() && entries_.back().m == m) {
+                ++entries_.back().count;
+            } else {
+                entries_.push_back(entry{m, 1});
+            }
+        }
+
+        void pop_back() noexcept {
+            if(--entries_.back().count == 0) entries_.pop_back();
+        }
+
+        /** @brief pops all copies of the last memento at once;
+         *         undoing the same memento again is a no-op, so this is
+         *         what popping them one by one would amount to
+         */
+        void pop_run() noexcept { entries_.pop_back(); }
+
+        void clear() noexcept { entries_.clear(); }
+
+        template<class Pred>
+        bool any_of(Pred&& pred) const {
+            for(const auto& e : entries_) if(pred(e.m)) return true;
+            return false;
         }
+
+    private:
+        struct entry {
+            memento m;
+            std::size_t count;
+        };
+        small_vector<entry,8> entries_;
     };
 
     dfs_traverser pos_;
     dfs_traverser lastMatch_;
     dfs_traverser posAfterLastMatch_;
-    std::stack<dfs_traverser::memento> scopes_;
+    scope_stack scopes_;
     bool ignoreBlocks_ = false;
     bool repeatGroupStarted_ = false;
     bool repeatGroupContinues_ = false;
@@ -4357,33 +6678,50 @@ struct select_values {
     }
 };
 
+/** @brief false, if a selector never accepts value parameters */
+template<class ParamSelector>
+constexpr bool
+may_select_values(const ParamSelector&) noexcept { return true; }
+
+constexpr bool
+may_select_values(const select_flags&) noexcept { return false; }
+
 
 
 /*************************************************************************//**
  *
- * @brief result of a matching operation
+ * @brief result of a matching operation;
+ *        refers to the matching part of the argument by position & length
  *
  *****************************************************************************/
 class match_t {
 public:
     using size_type = arg_string::size_type;
 
-    match_t() = default;
+    match_t(): range_{0,0}, pos_{} {}
+
+    match_t(subrange r, scoped_dfs_traverser p):
+        range_{r}, pos_{std::move(p)}, num_{}
+    {}
 
-    match_t(arg_string s, scoped_dfs_traverser p):
-        str_{std::move(s)}, pos_{std::move(p)}
+    match_t(subrange r, scoped_dfs_traverser p, const scanned_number& num):
+        range_{r}, pos_{std::move(p)}, num_{num}
     {}
 
-    size_type length() const noexcept { return str_.size(); }
+    size_type at()     const noexcept { return range_.at(); }
+    size_type length() const noexcept { return range_.length(); }
 
-    const arg_string& str() const noexcept { return str_; }
     const scoped_dfs_traverser& pos() const noexcept { return pos_; }
 
+    /** @brief value of the whole argument if it was scanned as a number */
+    const scanned_number& number() const noexcept { return num_; }
+
     explicit operator bool() const noexcept { return bool(pos_); }
 
 private:
-    arg_string str_;
+    subrange range_;
     scoped_dfs_traverser pos_;
+    scanned_number num_;
 };
 
 
@@ -4403,9 +6741,10 @@ full_match(scoped_dfs_traverser pos, const arg_string& arg,
         if(pos->is_param()) {
             const auto& param = pos->as_param();
             if(select(param)) {
-                const auto match = param.match(arg);
+                scanned_number num;
+                const auto match = param.match(arg, num);
                 if(match && match.length() == arg.size()) {
-                    return match_t{arg, std::move(pos)};
+                    return match_t{match, std::move(pos), num};
                 }
             }
         }
@@ -4415,33 +6754,138 @@ full_match(scoped_dfs_traverser pos, const arg_string& arg,
 }
 
 
+//-------------------------------------------------------------------
+/**
+ * @brief first node in the sorted list 'nodes' with an index >= n;
+ *        std::numeric_limits<int>::max() if there is none
+ */
+template<class Nodes>
+inline int
+first_node_from(const Nodes& nodes, int n)
+{
+    const auto i = std::lower_bound(nodes.begin(), nodes.end(), n);
+    return i != nodes.end() ? *i : std::numeric_limits<int>::max();
+}
+
+
+//-------------------------------------------------------------------
+/**
+ * @brief finds the first parameter in the sorted list of parameter
+ *        nodes 'cands' that is reachable from 'pos' and returns it as
+ *        match of 'range';
+ *        the traversal can be omitted entirely if there are no candidates
+ *        in the subtree of the traversal root
+ */
+template<class Nodes>
+inline match_t
+first_reachable(scoped_dfs_traverser pos, const Nodes& cands, subrange range)
+{
+    if(!pos) return match_t{};
+
+    //no candidates in subtree of traversal root
+    const auto& t = *pos.base().table();
+    const auto root = pos.base().root();
+    auto fst = std::lower_bound(cands.begin(), cands.end(), root);
+    if(pos.may_leave_root()) {
+        fst = cands.begin();
+    }
+    else if(fst == cands.end() || *fst >= t[root].end()) {
+        return match_t{};
+    }
+
+    //siblings & groups without candidates can be skipped as a whole
+    const auto nextCandidate = [&](int n) {
+        return first_node_from(cands, n);
+    };
+
+    bool advanced = false;
+    while(pos) {
+        if(advanced && (pos.skip_to_candidate(nextCandidate) ||
+                        pos.skip_group(nextCandidate))) continue;
+        if(pos->is_param() &&
+            std::binary_search(fst, cands.end(), pos.base().node()))
+        {
+            return match_t{range, std::move(pos)};
+        }
+        ++pos;
+        advanced = true;
+    }
+    return match_t{};
+}
+
+
+//-------------------------------------------------------------------
+inline match_t
+full_match(scoped_dfs_traverser pos, const arg_string& arg,
+           const select_flags&)
+{
+    if(!pos) return match_t{};
+    const auto cands = pos.base().table()->flag_candidates(arg);
+    if(!cands) return match_t{};
+    return first_reachable(std::move(pos), *cands, subrange{0, arg.size()});
+}
+
+
+
+//-------------------------------------------------------------------
+/**
+ * @brief returns the longest flag of parameter node 'node' among the
+ *        given flag prefixes of an argument
+ */
+inline subrange
+longest_flag_prefix(const cli_table::flag_prefix_list& prefixes,
+                    int node)
+{
+    for(auto i = prefixes.rbegin(); i != prefixes.rend(); ++i) {
+        if(std::binary_search(i->params->begin(), i->params->end(), node)) {
+            return subrange{0, i->length};
+        }
+    }
+    return subrange{};
+}
+
+
 
 /*************************************************************************//**
  *
  * @brief finds the first parameter that matches any (non-empty) prefix
- *        of a given string;
+ *        of a given string from position 'at' on;
  *        candidate parameters are traversed using a scoped DFS traverser
  *
  *****************************************************************************/
 template<class ParamSelector>
 match_t
 longest_prefix_match(scoped_dfs_traverser pos, const arg_string& arg,
-                     const ParamSelector& select)
+                     arg_string::size_type at, const ParamSelector& select)
 {
+    if(!pos) return match_t{};
+
+    //flag prefixes of 'arg' are looked up once for all parameters
+    const auto prefixes = pos.base().table()->flag_prefixes(arg, at);
+    const bool values = may_select_values(select);
+    if(prefixes.empty() && !values) return match_t{};
+
+    const auto n = arg.size() - at;
     match_t longest;
 
     while(pos) {
         if(pos->is_param()) {
             const auto& param = pos->as_param();
             if(select(param)) {
-                auto match = param.match(arg);
+                const auto match = param.flags().empty()
+                    ? param.match(arg, at)
+                    : longest_flag_prefix(prefixes, pos.base().node());
+
                 if(match.prefix()) {
-                    if(match.length() == arg.size()) {
-                        return match_t{arg, std::move(pos)};
+                    if(match.length() == n) {
+                        return match_t{match, std::move(pos)};
                     }
                     else if(match.length() > longest.length()) {
-                        longest = match_t{arg.substr(match.at(), match.length()), 
-                                          pos};
+                        longest = match_t{match, pos};
+                        //no other flag can match a longer prefix
+                        if(!values && match.length() == prefixes.back().length) {
+                            return longest;
+                        }
                     }
                 }
             }
@@ -4453,6 +6897,103 @@ longest_prefix_match(scoped_dfs_traverser pos, const arg_string& arg,
 
 
 
+/*************************************************************************//**
+ *
+ * @brief matches of an argument with the parameters reachable from a
+ *        position that are needed after full flag matches and joined flag
+ *        matches have been ruled out; gathered in a single traversal
+ *
+ *****************************************************************************/
+struct reachable_matches
+{
+    /** @brief first value parameter that matches the whole argument */
+    match_t value;
+    /** @brief same as 'longest_prefix_match' with 'select_flags' */
+    match_t flagPrefix;
+    /** @brief same as 'longest_prefix_match' with 'select_all';
+     *         only valid if there is no 'value' match */
+    match_t prefix;
+};
+
+
+//-------------------------------------------------------------------
+inline reachable_matches
+gather_matches(scoped_dfs_traverser pos, const arg_string& arg)
+{
+    reachable_matches res;
+    if(!pos) return res;
+
+    //flag prefixes of 'arg' are looked up once for all parameters
+    const auto& t = *pos.base().table();
+    const auto prefixes = t.flag_prefixes(arg);
+
+    //siblings & groups without values and flag prefix candidates
+    //can be skipped
+    const auto nextCandidate = [&](int n) {
+        int c = first_node_from(t.value_nodes(), n);
+        for(const auto& p : prefixes) {
+            c = std::min(c, first_node_from(*p.params, n));
+        }
+        return c;
+    };
+
+    //a prefix match result is final if it covers the whole argument
+    bool flagPrefixDone = prefixes.empty();
+    bool prefixDone = false;
+
+    const auto update = [&](match_t& m, bool& done, const subrange& match) {
+        if(match.length() == arg.size()) {
+            m = match_t{match, pos};
+            done = true;
+        }
+        else if(match.length() > m.length()) {
+            m = match_t{match, pos};
+        }
+    };
+
+    //'prefix' is not needed any more once a 'value' match was found
+    bool advanced = false;
+    while(pos && !(flagPrefixDone && res.value)) {
+        if(advanced && (pos.skip_to_candidate(nextCandidate) ||
+                        pos.skip_group(nextCandidate))) continue;
+        if(pos->is_param()) {
+            const auto& param = pos->as_param();
+            if(param.flags().empty()) {
+                if(!res.value) {
+                    scanned_number num;
+                    const auto match = param.match(arg, num);
+                    if(match && match.length() == arg.size()) {
+                        res.value = match_t{match, pos, num};
+                    }
+                    else if(!prefixDone && match.prefix()) {
+                        update(res.prefix, prefixDone, match);
+                    }
+                }
+            }
+            else if(!flagPrefixDone || (!res.value && !prefixDone)) {
+                const auto match = longest_flag_prefix(prefixes, pos.base().node());
+                if(match.prefix()) {
+                    if(!flagPrefixDone) {
+                        update(res.flagPrefix, flagPrefixDone, match);
+                        //no other flag can match a longer prefix
+                        if(res.flagPrefix.length() == prefixes.back().length) {
+                            flagPrefixDone = true;
+                        }
+                    }
+                    if(!res.value && !prefixDone) {
+                        update(res.prefix, prefixDone, match);
+                    }
+                }
+            }
+        }
+        ++pos;
+        advanced = true;
+    }
+    return res;
+}
+
+
+
 /*************************************************************************//**
  *
  * @brief finds the first parameter that partially matches a given string;
@@ -4470,8 +7011,7 @@ partial_match(scoped_dfs_traverser pos, const arg_string& arg,
             if(select(param)) {
                 const auto match = param.match(arg);
                 if(match) {
-                    return match_t{arg.substr(match.at(), match.length()),
-                                   std::move(pos)};
+                    return match_t{match, std::move(pos)};
                 }
             }
         }
@@ -4480,6 +7020,15 @@ partial_match(scoped_dfs_traverser pos, const arg_string& arg,
     return match_t{};
 }
 
+
+
+/*************************************************************************//**
+ *
+ * @brief access to the table position of an arg mapping
+ *
+ *****************************************************************************/
+struct arg_mapping_access;
+
 } //namespace detail
 
 
@@ -4487,6 +7036,62 @@ partial_match(scoped_dfs_traverser pos, const arg_string& arg,
 
 
 
+/*************************************************************************//**
+ *
+ * @brief immutable, flattened representation of a command line interface
+ *        that the parser runs on;
+ *        compiling once and parsing many times avoids redoing the
+ *        preprocessing of the interface in every 'parse' call
+ *
+ *        Note: refers to (but does not own) the original group,
+ *        which must therefore outlive all compiled_cli objects
+ *        and must not be modified after compilation
+ *
+ *****************************************************************************/
+class compiled_cli
+{
+public:
+    using size_type = detail::cli_table::size_type;
+
+    //---------------------------------------------------------------
+    explicit
+    compiled_cli(const group& cli):
+        table_{std::make_shared<const detail::cli_table>(cli)}
+    {}
+
+    //---------------------------------------------------------------
+    /** @brief returns the original command line interface */
+    const group& root() const noexcept { return table_->root(); }
+
+    /** @brief returns number of nodes (groups and parameters) */
+    size_type size() const noexcept { return table_->size(); }
+
+    /** @brief read access to node table */
+    const detail::cli_table& table() const noexcept { return *table_; }
+
+private:
+    std::shared_ptr<const detail::cli_table> table_;
+};
+
+
+
+/*************************************************************************//**
+ *
+ * @brief makes a compiled, immutable representation of a
+ *        command line interface for repeated parsing
+ *
+ *****************************************************************************/
+inline compiled_cli
+compile(const group& cli)
+{
+    return compiled_cli{cli};
+}
+
+
+
+
+
+
 /***************************************************************//**
  *
  * @brief default command line arguments parser
@@ -4495,7 +7100,7 @@ partial_match(scoped_dfs_traverser pos, const arg_string& arg,
 class parser
 {
 public:
-    using dfs_traverser = group::depth_first_traverser;
+    using dfs_traverser = detail::cli_traverser;
     using scoped_dfs_traverser = detail::scoped_dfs_traverser;
 
 
@@ -4505,30 +7110,37 @@ public:
     class arg_mapping {
     public:
         friend class parser;
+        friend struct detail::arg_mapping_access;
 
         explicit
         arg_mapping(arg_index idx, arg_string s,
                     const dfs_traverser& match)
         :
-            index_{idx}, arg_{std::move(s)}, match_{match},
-            repeat_{0}, startsRepeatGroup_{false},
+            index_{idx}, node_{match.node()}, root_{match.root()},
+            repeat_{0},
+            param_{match && match->is_param() ? &(match->as_param()) : nullptr},
+            arg_{std::move(s)},
+            significand_{0}, exponent_{0}, negative_{false}, numberKind_{0},
+            startsRepeatGroup_{false},
+            inRepeatGroup_{match.innermost_repeat_group() >= 0},
             blocked_{false}, conflict_{false}
         {}
 
         explicit
         arg_mapping(arg_index idx, arg_string s) :
-            index_{idx}, arg_{std::move(s)}, match_{},
-            repeat_{0}, startsRepeatGroup_{false},
+            index_{idx}, node_{-1}, root_{-1},
+            repeat_{0},
+            param_{nullptr},
+            arg_{std::move(s)},
+            significand_{0}, exponent_{0}, negative_{false}, numberKind_{0},
+            startsRepeatGroup_{false}, inRepeatGroup_{false},
             blocked_{false}, conflict_{false}
         {}
 
         arg_index index() const noexcept { return index_; }
         const arg_string& arg() const noexcept { return arg_; }
 
-        const parameter* param() const noexcept {
-            return match_ && match_->is_param()
-                ? &(match_->as_param()) : nullptr;
-        }
+        const parameter* param() const noexcept { return param_; }
 
         std::size_t repeat() const noexcept { return repeat_; }
 
@@ -4537,22 +7149,53 @@ public:
 
         bool bad_repeat() const noexcept {
             if(!param()) return false;
-            return repeat_ > 0 && !param()->repeatable()
-                && !match_.innermost_repeat_group();
+            return repeat_ > 0 && !param()->repeatable() && !inRepeatGroup_;
         }
 
         bool any_error() const noexcept {
-            return !match_ || blocked() || conflict() || bad_repeat();
+            return !param() || blocked() || conflict() || bad_repeat();
+        }
+
+        /** @brief value of the argument, if it was scanned as a number
+         *         while being matched with a number/integer parameter
+         */
+        detail::scanned_number scanned() const noexcept {
+            detail::scanned_number num;
+            num.kind = detail::number_kind(numberKind_);
+            num.negative = negative_;
+            num.exponent = int(exponent_) + detail::scanned_number::min_exponent;
+            num.significand = significand_;
+            return num;
         }
 
     private:
+        void scanned(const detail::scanned_number& num) noexcept {
+            numberKind_ = std::uint64_t(num.kind) & 0x3u;
+            negative_ = num.negative;
+            exponent_ = std::uint64_t(num.exponent -
+                            detail::scanned_number::min_exponent) & 0x1fu;
+            significand_ = num.significand &
+                           detail::scanned_number::max_significand;
+        }
+
+        //one mapping per argument (or joined part): the match's context
+        //is only kept as node index within the compiled table and index
+        //of the traversal root; a scanned number and the statuses
+        //are packed into the bit fields of one 64 bit word
         arg_index index_;
+        int node_;
+        int root_;
+        std::uint32_t repeat_;
+        const parameter* param_;
         arg_string arg_;
-        dfs_traverser match_;
-        std::size_t repeat_;
-        bool startsRepeatGroup_;
-        bool blocked_;
-        bool conflict_;
+        std::uint64_t significand_ : 52;
+        std::uint64_t exponent_ : 5;
+        std::uint64_t negative_ : 1;
+        std::uint64_t numberKind_ : 2;
+        std::uint64_t startsRepeatGroup_ : 1;
+        std::uint64_t inRepeatGroup_ : 1;
+        std::uint64_t blocked_ : 1;
+        std::uint64_t conflict_ : 1;
     };
 
     /*****************************************************//**
@@ -4565,33 +7208,338 @@ public:
             param_{p}, aftIndex_{after}
         {}
 
-        const parameter* param() const noexcept { return param_; }
+        const parameter* param() const noexcept { return param_; }
+
+        arg_index after_index() const noexcept { return aftIndex_; }
+
+    private:
+        const parameter* param_;
+        arg_index aftIndex_;
+    };
+
+    //-----------------------------------------------------
+    using missing_events = detail::pooled_vector<missing_event>;
+    using arg_mappings   = detail::pooled_vector<arg_mapping>;
+
+
+    /*****************************************************//**
+     * @brief receives parsing events as soon as they are decided
+     *        (see 'parser::observe' and 'stream_parse')
+     *********************************************************/
+    class observer {
+    public:
+        using mapping_action = std::function<void(const arg_mapping&)>;
+        using param_action   = std::function<void(const parameter&,arg_index)>;
+
+        /** @brief called for each arg mapping (including arguments that
+         *         couldn't be mapped) right after its argument has been
+         *         processed; the mapping's repeat, blocked and conflict
+         *         states are those known at that time
+         */
+        observer& on_match(mapping_action a) {
+            match_ = std::move(a);
+            return *this;
+        }
+
+        /** @brief called if an already reported match conflicts with
+         *         a match of a later argument
+         */
+        observer& on_late_conflict(param_action a) {
+            lateConflict_ = std::move(a);
+            return *this;
+        }
+
+        /** @brief called for each required parameter that was not
+         *         matched (by 'stream_parse' after the last argument)
+         */
+        observer& on_missing(param_action a) {
+            missing_ = std::move(a);
+            return *this;
+        }
+
+        void notify_match(const arg_mapping& m) const {
+            if(match_) match_(m);
+        }
+        void notify_late_conflict(const parameter& p, arg_index idx) const {
+            if(lateConflict_) lateConflict_(p, idx);
+        }
+        void notify_missing(const parameter& p, arg_index idx) const {
+            if(missing_) missing_(p, idx);
+        }
+
+    private:
+        mapping_action match_;
+        param_action lateConflict_;
+        param_action missing_;
+    };
+
+
+private:
+    /*****************************************************//**
+     * @brief ordered list of required parameters that were not
+     *        matched (yet); entries are indexed by node and by
+     *        surrounding exclusive groups, so that no operation
+     *        needs to scan the whole list
+     *********************************************************/
+    class miss_candidates {
+    public:
+        struct entry {
+            int node;
+            int root;
+            arg_index index;
+            bool startsRepeatGroup;
+            bool alive;
+            int prev;
+            int next;
+        };
+
+        miss_candidates() = default;
+
+        miss_candidates(const detail::cli_table& t, int root,
+                        detail::memory_resource* res)
+        :
+            t_{&t}, root_{root},
+            entries_{detail::make_pooled_vector<entry>(res)},
+            nodes_{detail::make_pooled_vector<node_info>(res)},
+            flagged_{detail::make_pooled_vector<int>(res)}
+        {}
+
+        bool empty() const noexcept { return size_ == 0; }
+        std::size_t size() const noexcept { return size_; }
+
+        /** @brief replaces contents with those of 'o' (which must refer
+         *         to the same table & root); memory is reused
+         */
+        void assign(const miss_candidates& o)
+        {
+            t_ = o.t_;
+            root_ = o.root_;
+            entries_.assign(o.entries_.begin(), o.entries_.end());
+            flagged_.assign(o.flagged_.begin(), o.flagged_.end());
+            if(nodes_.size() != o.nodes_.size()) {
+                nodes_.clear();
+                nodes_.reserve(o.nodes_.size());
+                for(std::size_t i = 0; i < o.nodes_.size(); ++i) {
+                    nodes_.emplace_back(res());
+                }
+            }
+            for(std::size_t i = 0; i < o.nodes_.size(); ++i) {
+                nodes_[i] = o.nodes_[i];
+            }
+            first_ = o.first_;
+            last_ = o.last_;
+            size_ = o.size_;
+        }
+
+        /** @brief sets argument index of all entries */
+        void set_index(arg_index idx) noexcept {
+            for(auto& e : entries_) e.index = idx;
+        }
+
+        /** @brief calls 'f(entry)' for all entries in insertion order */
+        template<class Action>
+        void for_each(Action&& f) const {
+            for(int i = first_; i >= 0; i = entries_[std::size_t(i)].next) {
+                f(entries_[std::size_t(i)]);
+            }
+        }
+
+        /** @brief true, if there is any entry for parameter node 'n' */
+        bool contains(int n) const noexcept {
+            return !nodes_.empty() && info(n).count > 0;
+        }
+
+        void push_back(const dfs_traverser& p, arg_index idx,
+                       bool startsRepeatGroup = false)
+        {
+            if(nodes_.empty()) {
+                const auto n = std::size_t((*t_)[root_].end() - root_);
+                nodes_.reserve(n);
+                //per-node lists use the same memory resource
+                for(std::size_t i = 0; i < n; ++i) nodes_.emplace_back(res());
+            }
+            //erased entries are kept as tombstones until they outnumber
+            //the live ones, e.g. when streaming many repeat cycles
+            if(entries_.size() >= 2 * size_ + 16) compact();
+
+            const int e = int(entries_.size());
+            entries_.push_back(entry{p.node(), p.root(), idx,
+                                     startsRepeatGroup, true, last_, -1});
+            if(last_ >= 0) entries_[std::size_t(last_)].next = e;
+            else first_ = e;
+            last_ = e;
+            ++size_;
+
+            if(startsRepeatGroup) flagged_.push_back(e);
+            auto& ni = info(p.node());
+            ++ni.count;
+            ni.entries.push_back(e);
+            for_each_alternative(e, [&](int x, int g) {
+                ++info(x).inAlternative;
+                ++info(g).inside;
+                info(g).entries.push_back(e);
+            });
+        }
+
+        /** @brief removes last entry for parameter node 'n' */
+        void erase_last_of(int n)
+        {
+            if(!contains(n)) return;
+            auto& es = info(n).entries;
+            while(!entries_[std::size_t(es.back())].alive) es.pop_back();
+            erase(es.back());
+            es.pop_back();
+        }
+
+        /**
+         * @brief removes entries that are inside exclusive group 'g' but
+         *        not inside its child 'm', going backwards from the last
+         *        entry and stopping at the start of the current repeat
+         *        cycle
+         */
+        void discard_alternatives(int g, int m)
+        {
+            if(empty() || info(g).inside == info(m).inAlternative) return;
+
+            const auto& ges = info(g).entries;
+            int j = int(ges.size()) - 1;
+            while(true) {
+                //last entry that starts a repeat cycle
+                while(!flagged_.empty() && !alive(flagged_.back())) {
+                    flagged_.pop_back();
+                }
+                const int f = flagged_.empty() ? -1 : flagged_.back();
+                //its successor; if this is discarded we stop before 'f'
+                const int s = f < 0 ? first_ : entries_[std::size_t(f)].next;
+
+                for(; j >= 0 && ges[std::size_t(j)] > f; --j) {
+                    const int e = ges[std::size_t(j)];
+                    if(alive(e) && !t_->inside_or_self(node_of(e), m)) {
+                        erase(e);
+                        if(empty()) return;
+                    }
+                }
+                if(f < 0 || (s >= 0 && !alive(s))) return;
+
+                const auto& fe = entries_[std::size_t(f)];
+                if(!(g >= fe.root && t_->inside(fe.node, g) &&
+                     !t_->inside_or_self(fe.node, m))) return;
+
+                const int p = fe.prev;
+                erase(f);
+                if(empty() || p < 0 || entries_[std::size_t(p)].startsRepeatGroup) {
+                    return;
+                }
+            }
+        }
+
+    private:
+        struct node_info {
+            explicit
+            node_info(detail::memory_resource* res):
+                entries{detail::make_pooled_vector<int>(res)}
+            {}
+            //entries for parameter node
+            int count = 0;
+            //entries inside node, where node's parent is exclusive
+            int inAlternative = 0;
+            //entries inside (exclusive group) node
+            int inside = 0;
+            //entries at param node / entries inside exclusive group node
+            detail::pooled_vector<int> entries;
+        };
+
+        detail::memory_resource* res() const noexcept {
+#ifdef CLIPP_HAS_PMR
+            return entries_.get_allocator().resource();
+#else
+            return nullptr;
+#endif
+        }
 
-        arg_index after_index() const noexcept { return aftIndex_; }
+        node_info& info(int n) { return nodes_[std::size_t(n - root_)]; }
+        const node_info& info(int n) const {
+            return nodes_[std::size_t(n - root_)];
+        }
 
-    private:
-        const parameter* param_;
-        arg_index aftIndex_;
-    };
+        bool alive(int e) const noexcept {
+            return entries_[std::size_t(e)].alive;
+        }
+        int node_of(int e) const noexcept {
+            return entries_[std::size_t(e)].node;
+        }
 
-    //-----------------------------------------------------
-    using missing_events = std::vector<missing_event>;
-    using arg_mappings   = std::vector<arg_mapping>;
+        /** @brief calls 'f(x,g)' for all nodes 'x' on the path from entry's
+         *         node to its root whose parent 'g' is an exclusive group */
+        template<class Action>
+        void for_each_alternative(int e, Action&& f) const {
+            const auto& c = entries_[std::size_t(e)];
+            for(int x = c.node; t_->inside(x, c.root); x = (*t_)[x].parent()) {
+                const int g = (*t_)[x].parent();
+                if((*t_)[g].exclusive()) f(x, g);
+            }
+        }
 
+        /** @brief removes erased entries; keeps the order of live entries,
+         *         so that entry indices stay comparable
+         */
+        void compact()
+        {
+            //new index of each live entry (links are rebuilt anyway)
+            int k = 0;
+            for(auto& c : entries_) {
+                if(c.alive) c.next = k++;
+            }
+            const auto relink = [this](detail::pooled_vector<int>& es) {
+                std::size_t j = 0;
+                for(const auto e : es) {
+                    if(alive(e)) es[j++] = entries_[std::size_t(e)].next;
+                }
+                es.erase(es.begin() + std::ptrdiff_t(j), es.end());
+            };
+            for(auto& ni : nodes_) relink(ni.entries);
+            relink(flagged_);
+
+            std::size_t j = 0;
+            for(const auto& c : entries_) {
+                if(c.alive) entries_[j++] = c;
+            }
+            entries_.erase(entries_.begin() + std::ptrdiff_t(j), entries_.end());
+            for(std::size_t i = 0; i < j; ++i) {
+                entries_[i].prev = int(i) - 1;
+                entries_[i].next = i + 1 < j ? int(i) + 1 : -1;
+            }
+            first_ = j > 0 ? 0 : -1;
+            last_ = int(j) - 1;
+        }
 
-private:
-    struct miss_candidate {
-        miss_candidate(dfs_traverser p, arg_index idx,
-                       bool firstInRepeatGroup = false):
-            pos{std::move(p)}, index{idx},
-            startsRepeatGroup{firstInRepeatGroup}
-        {}
+        void erase(int e)
+        {
+            auto& c = entries_[std::size_t(e)];
+            c.alive = false;
+            if(c.prev >= 0) entries_[std::size_t(c.prev)].next = c.next;
+            else first_ = c.next;
+            if(c.next >= 0) entries_[std::size_t(c.next)].prev = c.prev;
+            else last_ = c.prev;
+            --size_;
+
+            --info(c.node).count;
+            for_each_alternative(e, [&](int x, int g) {
+                --info(x).inAlternative;
+                --info(g).inside;
+            });
+        }
 
-        dfs_traverser pos;
-        arg_index index;
-        bool startsRepeatGroup;
+        const detail::cli_table* t_ = nullptr;
+        int root_ = 0;
+        detail::pooled_vector<entry> entries_;
+        detail::pooled_vector<node_info> nodes_;
+        //entries that start a repeat cycle (might contain erased ones)
+        detail::pooled_vector<int> flagged_;
+        int first_ = -1;
+        int last_ = -1;
+        std::size_t size_ = 0;
     };
-    using miss_candidates = std::vector<miss_candidate>;
 
 
 public:
@@ -4601,14 +7549,78 @@ public:
      * */
     explicit
     parser(const group& root, arg_index offset = 0):
-        root_{&root}, pos_{root},
-        index_{offset-1}, eaten_{0},
-        args_{}, missCand_{}, blocked_{false}
+        parser{compiled_cli{root}, 0, offset, nullptr}
+    {}
+
+    /** @brief initializes parser with a compiled command line interface
+     *  @param offset = argument index offset used for reports
+     * */
+    explicit
+    parser(const compiled_cli& cli, arg_index offset = 0):
+        parser{cli, 0, offset, nullptr}
+    {}
+
+#ifdef CLIPP_HAS_PMR
+    /** @brief initializes parser with a compiled command line interface;
+     *         parser state and arg mappings are allocated from 'res'
+     *         which must outlive the parser and everything moved out of it
+     *  @param offset = argument index offset used for reports
+     * */
+    explicit
+    parser(const compiled_cli& cli, std::pmr::memory_resource* res,
+           arg_index offset = 0)
+    :
+        parser{cli, 0, offset, res}
+    {}
+#endif
+
+
+    //---------------------------------------------------------------
+    /** @brief restores the state right after construction, so that the
+     *         parser can be reused for another command line;
+     *         keeps all allocated memory and doesn't need to traverse
+     *         the command line interface again
+     *  @param offset = argument index offset used for reports
+     */
+    void reset(arg_index offset = 0)
     {
-        for_each_potential_miss(dfs_traverser{root},
-            [this](const dfs_traverser& p){
-                missCand_.emplace_back(p, index_);
-            });
+        if(!hasSnapshot_) {
+            //initial miss candidates (with argument index -1)
+            for_each_potential_miss(dfs_traverser{table(), root_},
+                [this](const dfs_traverser& p){
+                    initialMissCand_.push_back(p, -1);
+                });
+            hasSnapshot_ = true;
+        }
+
+        pos_ = scoped_dfs_traverser{table(), root_};
+        index_ = offset - 1;
+        eaten_ = 0;
+        args_.clear();
+        missCand_.assign(initialMissCand_);
+        if(index_ != -1) missCand_.set_index(index_);
+        std::fill(occurrences_.begin(), occurrences_.end(), 0);
+        start_repeat_cycle();
+        wholeArgs_.clear();
+        specBegin_ = 0;
+        dropped_ = 0;
+        conflicting_.clear();
+        reported_ = 0;
+        blocked_ = false;
+        speculative_ = false;
+    }
+
+
+    //---------------------------------------------------------------
+    /** @brief reports parsing events to 'obs' (null: none) which must
+     *         outlive the parser
+     *  @param retainArgs = if false, arg mappings are discarded as soon as
+     *         they have been reported, so that 'args()' will only contain
+     *         the mappings of the last processed argument
+     */
+    void observe(const observer* obs, bool retainArgs = true) noexcept {
+        observer_ = obs;
+        retainArgs_ = retainArgs;
     }
 
 
@@ -4616,38 +7628,58 @@ public:
     /** @brief processes one command line argument */
     bool operator() (const arg_string& arg)
     {
-        ++eaten_;
-        ++index_;
-
-        if(!valid()) return false;
-
-        if(!blocked_ && try_match(arg)) return true;
-
-        if(try_match_blocked(arg)) return false;
+        const bool matched = process(arg);
+        for(auto i : wholeArgs_) args_[i].arg_ = arg;
+        report_args();
+        return matched;
+    }
 
-        //skipping of blocking & required patterns is not allowed
-        if(!blocked_ && !pos_.matched() && pos_->required() && pos_->blocking()) {
-            blocked_ = true;
+    /** @brief processes one command line argument;
+     *         the string is moved into the arg mapping if possible
+     */
+    bool operator() (arg_string&& arg)
+    {
+        const bool matched = process(arg);
+        if(!wholeArgs_.empty()) {
+            for(auto i = wholeArgs_.begin(); i+1 != wholeArgs_.end(); ++i) {
+                args_[*i].arg_ = arg;
+            }
+            args_[wholeArgs_.back()].arg_ = std::move(arg);
         }
-
-        add_nomatch(arg);
-        return false;
+        report_args();
+        return matched;
     }
 
 
     //---------------------------------------------------------------
     /** @brief returns range of argument -> parameter mappings */
-    const arg_mappings& args() const {
+    const arg_mappings& args() const & {
         return args_;
     }
 
+    /** @brief moves argument -> parameter mappings out of the parser */
+    arg_mappings args() && {
+        return std::move(args_);
+    }
+
+    /** @brief moves argument -> parameter mappings into a new container;
+     *         the parser keeps its (then empty) buffer for reuse
+     */
+    arg_mappings extract_args() {
+        auto mappings = detail::make_pooled_vector<arg_mapping>(res_);
+        mappings.assign(std::make_move_iterator(args_.begin()),
+                        std::make_move_iterator(args_.end()));
+        args_.clear();
+        return mappings;
+    }
+
     /** @brief returns list of missing events */
     missing_events missed() const {
-        missing_events misses;
+        auto misses = detail::make_pooled_vector<missing_event>(res_);
         misses.reserve(missCand_.size());
-        for(auto i = missCand_.begin(); i != missCand_.end(); ++i) {
-            misses.emplace_back(&(i->pos->as_param()), i->index);
-        }
+        missCand_.for_each([&](const miss_candidates::entry& c) {
+            misses.emplace_back(&(table()[c.node].as_param()), c.index);
+        });
         return misses;
     }
 
@@ -4671,36 +7703,119 @@ private:
 
 
     //---------------------------------------------------------------
-    /** @brief try to match argument with unreachable parameter */
-    bool try_match_blocked(const arg_string& arg)
+    /** @brief parser with node 'root' of 'cli' as top-level group
+     *  @param res = memory resource for parser state (null: default)
+     *  @param speculative = if true, missing parameters are not tracked
+     */
+    explicit
+    parser(const compiled_cli& cli, int root, arg_index offset,
+           detail::memory_resource* res, bool speculative = false)
+    :
+        cli_{cli}, root_{root}, pos_{cli.table(), root},
+        index_{offset-1}, eaten_{0},
+        res_{res},
+        args_{detail::make_pooled_vector<arg_mapping>(res)},
+        missCand_{cli.table(), root, res},
+        initialMissCand_{cli.table(), root, res}, hasSnapshot_{false},
+        occurrences_{detail::make_pooled_vector<std::size_t>(res)},
+        alternatives_{detail::make_pooled_vector<alternative_state>(res)},
+        wholeArgs_{detail::make_pooled_vector<std::size_t>(res)},
+        cycle_{1}, specBegin_{0},
+        observer_{nullptr}, dropped_{0},
+        conflicting_{detail::make_pooled_vector<std::size_t>(res)},
+        reported_{0}, retainArgs_{true},
+        blocked_{false}, speculative_{speculative}
     {
-        //try to match ahead (using temporary parser)
-        if(pos_) {
-            auto ahead = *this;
-            if(try_match_blocked(std::move(ahead), arg)) return true;
-        }
+        if(speculative_) return;
+        for_each_potential_miss(dfs_traverser{table(), root_},
+            [this](const dfs_traverser& p){
+                missCand_.push_back(p, index_);
+            });
+    }
 
-        //try to match from the beginning (using temporary parser)
-        if(root_) {
-            parser all{*root_, index_+1};
-            if(try_match_blocked(std::move(all), arg)) return true;
+    //---------------------------------------------------------------
+    const detail::cli_table& table() const noexcept {
+        return cli_.table();
+    }
+
+
+    //---------------------------------------------------------------
+    /** @brief matches one command line argument; the arg mappings that
+     *         refer to the whole argument (listed in 'wholeArgs_') are
+     *         left without string which has to be assigned afterwards
+     */
+    bool process(const arg_string& arg)
+    {
+        ++eaten_;
+        ++index_;
+        wholeArgs_.clear();
+        if(!retainArgs_) drop_args();
+
+        if(!valid()) return false;
+
+        if(!blocked_ && try_match(arg)) return true;
+
+        if(try_match_blocked(arg)) return false;
+
+        //skipping of blocking & required patterns is not allowed
+        if(!blocked_ && !pos_.matched() && pos_->required() && pos_->blocking()) {
+            blocked_ = true;
         }
 
+        add_nomatch();
         return false;
     }
 
+
     //---------------------------------------------------------------
-    bool try_match_blocked(parser&& parse, const arg_string& arg)
+    /** @brief try to match argument with unreachable parameter */
+    bool try_match_blocked(const arg_string& arg)
     {
-        const auto nold = int(parse.args_.size());
+        //try to match ahead
+        if(pos_ && try_match_ahead(arg)) return true;
+
+        //try to match from the beginning (using temporary parser)
+        parser all{cli_, root_, index_+1, res_, true};
+        all.pos_.ignore_blocking(true);
 
-        parse.pos_.ignore_blocking(true);
+        if(!all.try_match(arg)) return false;
 
-        if(!parse.try_match(arg)) return false;
+        for(auto i : all.wholeArgs_) wholeArgs_.push_back(args_.size() + i);
 
-        for(auto i = parse.args_.begin() + nold; i != parse.args_.end(); ++i) {
-            args_.push_back(*i);
+        for(auto& a : all.args_) {
+            args_.push_back(std::move(a));
             args_.back().blocked_ = true;
+            if(args_.back().startsRepeatGroup_) start_repeat_cycle();
+            count_occurrence(args_.back());
+        }
+        return true;
+    }
+
+    //---------------------------------------------------------------
+    /** @brief speculatively matches 'arg' while ignoring blocking params;
+     *         afterwards all state changes except for the new (blocked)
+     *         arg mappings are rolled back
+     */
+    bool try_match_ahead(const arg_string& arg)
+    {
+        //checkpoint
+        const auto nold = args_.size();
+        const auto pos = pos_;
+
+        speculative_ = true;
+        specBegin_ = nold;
+        pos_.ignore_blocking(true);
+        const bool matched = try_match(arg);
+
+        //rollback
+        speculative_ = false;
+        pos_ = pos;
+
+        if(!matched) return false;
+
+        for(auto i = args_.begin() + nold; i != args_.end(); ++i) {
+            i->blocked_ = true;
+            if(i->startsRepeatGroup_) start_repeat_cycle();
         }
         return true;
     }
@@ -4711,22 +7826,30 @@ private:
     {
         //match greedy parameters before everything else
         if(pos_->is_param() && pos_->blocking() && pos_->as_param().greedy()) {
-            const auto match = pos_->as_param().match(arg);
+            detail::scanned_number num;
+            const auto match = pos_->as_param().match(arg, num);
             if(match && match.length() == arg.size()) {
-                add_match(detail::match_t{arg,pos_});
+                add_match(detail::match_t{match,pos_,num});
                 return true;
             }
         }
 
         //try flags first (alone, joinable or strict sequence)
         if(try_match_full(arg, detail::select_flags{})) return true;
-        if(try_match_joined_flags(arg)) return true;
-        if(try_match_joined_sequence(arg, detail::select_flags{})) return true;
+        const auto joinGroups = join_groups(pos_);
+        if(try_match_joined_flags(arg, joinGroups)) return true;
+
+        //candidates for all remaining cases are found in one traversal
+        const auto cands = detail::gather_matches(pos_, arg);
+        if(try_match_joined_sequence(arg, cands.flagPrefix)) return true;
         //try value params (alone or strict sequence)
-        if(try_match_full(arg, detail::select_values{})) return true;
-        if(try_match_joined_sequence(arg, detail::select_all{})) return true;
+        if(cands.value) {
+            add_match(cands.value);
+            return true;
+        }
+        if(try_match_joined_sequence(arg, cands.prefix)) return true;
         //try joinable params + values in any order
-        if(try_match_joined_params(arg)) return true;
+        if(try_match_joined_params(arg, joinGroups)) return true;
         return false;
     }
 
@@ -4747,18 +7870,13 @@ private:
     //---------------------------------------------------------------
     /**
      * @brief try to match argument as blocking sequence of parameters
-     * @param select : predicate that a parameter matching the prefix of
-     *                 'arg' must satisfy
+     * @param fstMatch : longest prefix match of 'arg'
      */
-    template<class ParamSelector>
-    bool try_match_joined_sequence(arg_string arg,
-                                   const ParamSelector& acceptFirst)
+    bool try_match_joined_sequence(const arg_string& arg, match_t fstMatch)
     {
-        auto fstMatch = detail::longest_prefix_match(pos_, arg, acceptFirst);
-
         if(!fstMatch) return false;
 
-        if(fstMatch.str().size() == arg.size()) {
+        if(fstMatch.length() == arg.size()) {
             add_match(fstMatch);
             return true;
         }
@@ -4767,21 +7885,24 @@ private:
 
         auto pos = fstMatch.pos();
         pos.ignore_blocking(true);
-        const auto parent = &pos.parent();
+        const auto parent = pos.parent_node();
         if(!pos->repeatable()) ++pos;
 
-        arg.erase(0, fstMatch.str().size());
+        //matched parts of 'arg'; only copied if the whole sequence matches
+        std::vector<subrange> parts { subrange{0, fstMatch.length()} };
+        auto at = fstMatch.length();
         std::vector<match_t> matches { std::move(fstMatch) };
 
-        while(!arg.empty() && pos &&
+        while(at < arg.size() && pos &&
               pos->blocking() && pos->is_param() &&
-              (&pos.parent() == parent))
+              (pos.parent_node() == parent))
         {
-            auto match = pos->as_param().match(arg);
+            auto match = pos->as_param().match(arg, at);
 
             if(match.prefix()) {
-                matches.emplace_back(arg.substr(0,match.length()), pos);
-                arg.erase(0, match.length());
+                matches.emplace_back(match, pos);
+                parts.emplace_back(at, match.length());
+                at += match.length();
                 if(!pos->repeatable()) ++pos;
             }
             else {
@@ -4791,29 +7912,42 @@ private:
 
         }
         //if arg not fully covered => discard temporary matches
-        if(!arg.empty() || matches.empty()) return false;
+        if(at < arg.size() || matches.empty()) return false;
 
-        for(const auto& m : matches) add_match(m);
+        for(std::size_t i = 0; i < matches.size(); ++i) {
+            add_match(matches[i], arg.substr(parts[i].at(), parts[i].length()));
+        }
         return true;
     }
 
     //-----------------------------------------------------
+    using group_list = detail::small_vector<int,8>;
+
     /** @brief try to match 'arg' as a concatenation of joinable flags */
-    bool try_match_joined_flags(const arg_string& arg)
+    bool try_match_joined_flags(const arg_string& arg,
+                                const group_list& joinGroups)
     {
-        return find_join_group(pos_, [&](const group& g) {
-            return try_match_joined(g, arg, detail::select_flags{},
-                                    g.common_flag_prefix());
-        });
+        for(int g : joinGroups) {
+            const auto& join = table().join_info_of(g);
+            if(join.shortFlags.empty()
+                ? try_match_joined(g, arg, detail::select_flags{}, join.prefix)
+                : try_match_short_flags(g, arg, join))
+            {
+                return true;
+            }
+        }
+        return false;
     }
 
     //---------------------------------------------------------------
     /** @brief try to match 'arg' as a concatenation of joinable parameters */
-    bool try_match_joined_params(const arg_string& arg)
+    bool try_match_joined_params(const arg_string& arg,
+                                 const group_list& joinGroups)
     {
-        return find_join_group(pos_, [&](const group& g) {
-            return try_match_joined(g, arg, detail::select_all{});
-        });
+        for(int g : joinGroups) {
+            if(try_match_joined(g, arg, detail::select_all{})) return true;
+        }
+        return false;
     }
 
     //-----------------------------------------------------
@@ -4821,88 +7955,229 @@ private:
      *         that are all contained within one group
      */
     template<class ParamSelector>
-    bool try_match_joined(const group& joinGroup, arg_string arg,
+    bool try_match_joined(int joinGroup, const arg_string& arg,
                           const ParamSelector& select,
                           const arg_string& prefix = "")
     {
         //temporary parser with 'joinGroup' as top-level group
-        parser parse {joinGroup};
+        parser parse {cli_, joinGroup, 0, res_};
         //records temporary matches
         std::vector<match_t> matches;
+        std::vector<arg_string> parts;
+
+        //unmatched rest of 'arg': re-inserted prefixes in 'head'
+        //followed by 'arg' from position 'at' on
+        arg_string head;
+        auto at = arg_string::size_type(0);
+
+        const auto restStartsWithPrefix = [&] {
+            const auto n = prefix.size();
+            const auto k = std::min(head.size(), n);
+            return head.compare(0, k, prefix, 0, k) == 0 &&
+                   arg.compare(at, n - k, prefix, k, n - k) == 0;
+        };
+
+        //flags can't be longer than the longest flag
+        const auto window = detail::may_select_values(select)
+            ? arg_string::npos : table().max_flag_length();
+        arg_string rest;
 
-        while(!arg.empty()) {
-            auto match = detail::longest_prefix_match(parse.pos_, arg, select);
+        while(!head.empty() || at < arg.size()) {
+            match_t match;
+            if(head.empty()) {
+                //match in place
+                match = detail::longest_prefix_match(parse.pos_, arg, at, select);
+            }
+            else {
+                rest = head;
+                if(window > head.size()) rest.append(arg, at, window - head.size());
+                match = detail::longest_prefix_match(parse.pos_, rest, 0, select);
+            }
 
             if(!match) return false;
 
-            arg.erase(0, match.str().size());
+            const auto len = match.length();
+            parts.push_back(head.empty() ? arg.substr(at, len)
+                                         : rest.substr(0, len));
+            if(len < head.size()) {
+                head.erase(0, len);
+            } else {
+                at += len - head.size();
+                head.clear();
+            }
             //make sure prefix is always present after the first match
             //so that, e.g., flags "-a" and "-b" will be found in "-ab"
-            if(!arg.empty() && !prefix.empty() && arg.find(prefix) != 0 &&
-                prefix != match.str())
+            if((!head.empty() || at < arg.size()) && !prefix.empty() &&
+                !restStartsWithPrefix() && prefix != parts.back())
             {
-                arg.insert(0,prefix);
+                head.insert(0,prefix);
             }
 
-            parse.add_match(match);
+            parse.add_match(match, arg_string{});
             matches.push_back(std::move(match));
         }
 
-        if(!arg.empty() || matches.empty()) return false;
+        if(matches.empty()) return false;
+
+        if(!parse.missCand_.empty()) return false;
+        for(const auto& a : parse.args_) if(a.any_error()) return false;
+
+        //replay matches onto *this
+        for(std::size_t i = 0; i < matches.size(); ++i) {
+            add_match(matches[i], std::move(parts[i]));
+        }
+        return true;
+    }
+
+    //-----------------------------------------------------
+    /** @brief try to match 'arg' as a cluster of single-character flags
+     *         (like "-xvzf") of joinable group 'joinGroup';
+     *         same as 'try_match_joined' with 'select_flags', but decodes
+     *         the cluster in one pass using the group's character table
+     */
+    bool try_match_short_flags(int joinGroup, const arg_string& arg,
+                               const detail::cli_table::join_info& join)
+    {
+        const auto& prefix = join.prefix;
+        const auto n = prefix.size();
+        //first flag must be given in full
+        if(arg.size() <= n || arg.compare(0, n, prefix) != 0) return false;
+
+        //temporary parser with 'joinGroup' as top-level group
+        parser parse {cli_, joinGroup, 0, res_};
+        //records temporary matches
+        std::vector<match_t> matches;
+        std::vector<arg_string> parts;
+
+        for(arg_string::size_type i = 0; i < arg.size(); ) {
+            //later flags may be given with or without prefix
+            const bool full = i == 0 ||
+                (n > 0 && arg.compare(i, n, prefix) == 0);
+            if(full && arg.size() - i <= n) return false;
+
+            const auto c = arg[full ? i + n : i];
+            const std::array<int,1> cands {{
+                join.shortFlags[static_cast<unsigned char>(c)] }};
+            if(cands[0] < 0) return false;
+
+            auto match = detail::first_reachable(parse.pos_, cands,
+                                                 subrange{0, n + 1});
+            if(!match) return false;
+
+            if(full) {
+                parts.push_back(arg.substr(i, n + 1));
+                i += n + 1;
+            } else {
+                parts.push_back(prefix + c);
+                ++i;
+            }
+
+            parse.add_match(match, arg_string{});
+            matches.push_back(std::move(match));
+        }
 
         if(!parse.missCand_.empty()) return false;
         for(const auto& a : parse.args_) if(a.any_error()) return false;
 
         //replay matches onto *this
-        for(const auto& m : matches) add_match(m);
+        for(std::size_t i = 0; i < matches.size(); ++i) {
+            add_match(matches[i], std::move(parts[i]));
+        }
         return true;
     }
 
     //-----------------------------------------------------
-    template<class GroupSelector>
-    bool find_join_group(const scoped_dfs_traverser& start,
-                         const GroupSelector& accept) const
+    /** @brief joinable groups in which matching can start at 'start' */
+    group_list join_groups(const scoped_dfs_traverser& start) const
     {
+        group_list groups;
         if(start && start.parent().joinable()) {
-            const auto& g = start.parent();
-            if(accept(g)) return true;
-            return false;
+            groups.push_back(start.parent_node());
+            return groups;
         }
 
+        const auto& t = table();
+        const auto nextCandidate = [&](int n) {
+            return detail::first_node_from(t.joinable_nodes(), n);
+        };
+
         auto pos = start;
+        bool advanced = false;
         while(pos) {
-            if(pos->is_group() && pos->as_group().joinable()) {
-                const auto& g = pos->as_group();
-                if(accept(g)) return true;
+            if(advanced && (pos.skip_to_candidate(nextCandidate) ||
+                            pos.skip_group(nextCandidate))) continue;
+            if(pos->is_group() && pos->joinable()) {
+                groups.push_back(pos.base().node());
                 pos.next_sibling();
+                advanced = false;
             }
             else {
                 ++pos;
+                advanced = true;
             }
         }
-        return false;
+        return groups;
+    }
+
+
+    //---------------------------------------------------------------
+    /** @brief discards all arg mappings; keeps track of conflicting ones */
+    void drop_args()
+    {
+        for(std::size_t i = 0; i < args_.size(); ++i) {
+            if(args_[i].conflict_) conflicting_.push_back(dropped_ + i);
+        }
+        dropped_ += args_.size();
+        args_.clear();
+    }
+
+    //---------------------------------------------------------------
+    /** @brief passes arg mappings of the last argument to the observer */
+    void report_args()
+    {
+        if(observer_) {
+            for(auto i = reported_ - dropped_; i < args_.size(); ++i) {
+                observer_->notify_match(args_[i]);
+            }
+        }
+        reported_ = dropped_ + args_.size();
     }
 
 
     //---------------------------------------------------------------
-    void add_nomatch(const arg_string& arg) {
-        args_.emplace_back(index_, arg);
+    void add_nomatch() {
+        wholeArgs_.push_back(args_.size());
+        args_.emplace_back(index_, arg_string{});
     }
 
 
     //---------------------------------------------------------------
+    /** @brief adds mapping of the whole current argument */
     void add_match(const match_t& match)
+    {
+        if(!match.pos() || !match.pos()->is_param()) return;
+        wholeArgs_.push_back(args_.size());
+        add_match(match, arg_string{});
+    }
+
+    /** @brief adds mapping of part 'arg' of the current argument */
+    void add_match(const match_t& match, arg_string arg)
     {
         const auto& pos = match.pos();
         if(!pos || !pos->is_param()) return;
 
         pos_.next_after_match(pos);
 
-        arg_mapping newArg{index_, match.str(), pos.base()};
-        newArg.repeat_ = occurrences_of(&pos->as_param());
+        arg_mapping newArg{index_, std::move(arg), pos.base()};
+        newArg.scanned(match.number());
+        newArg.repeat_ = std::uint32_t(occurrences_of(pos.base().node()));
         newArg.conflict_ = check_conflicts(pos.base());
         newArg.startsRepeatGroup_ = pos_.start_of_repeat_group();
         args_.push_back(std::move(newArg));
+        count_occurrence(args_.back());
+
+        //misses of speculative matches would be discarded anyway
+        if(speculative_) return;
 
         add_miss_candidates_after(pos);
         clean_miss_candidates_for(pos.base());
@@ -4911,73 +8186,202 @@ private:
     }
 
     //-----------------------------------------------------
-    bool check_conflicts(const dfs_traverser& match)
-    {
-        if(pos_.start_of_repeat_group()) return false;
-        bool conflict = false;
-        for(const auto& m : match.stack()) {
-            if(m.parent->exclusive()) {
-                for(auto i = args_.rbegin(); i != args_.rend(); ++i) {
-                    if(!i->blocked()) {
-                        for(const auto& c : i->match_.stack()) {
-                            //sibling within same exclusive group => conflict
-                            if(c.parent == m.parent && c.cur != m.cur) {
-                                conflict = true;
-                                i->conflict_ = true;
-                            }
-                        }
-                    }
-                    //check for conflicts only within current repeat cycle
-                    if(i->startsRepeatGroup_) break;
-                }
-            }
-        }
-        return conflict;
+    /** @brief checks if a new match conflicts with previous matches of
+     *         other alternatives within the current repeat cycle and
+     *         registers the new match (which gets index args_.size())
+     */
+    bool check_conflicts(const dfs_traverser& match)
+    {
+        if(speculative_) return check_speculative_conflicts(match);
+
+        const bool newCycle = pos_.start_of_repeat_group();
+        if(newCycle) start_repeat_cycle();
+
+        const auto idx = dropped_ + args_.size();
+        bool conflict = false;
+        //go through all exclusive groups 'g' of matching pattern;
+        //'m' is the child of 'g' on the path to the match
+        match.for_each_group_on_path([&](int g, int m) {
+            if(!table()[g].exclusive()) return;
+            auto& gs = alternative_state_of(g);
+            auto& ms = alternative_state_of(m);
+            //any previous match inside 'g' but not inside 'm'
+            if(!newCycle && gs.matchesInside > ms.matchesInAlternative) {
+                conflict = true;
+            }
+            //all matches of previously chosen alternative conflict
+            if(gs.chosen != m) {
+                for(const auto& c : gs.chosenArgs) flag_conflicts(c);
+                gs.chosenArgs.clear();
+                gs.chosen = m;
+            }
+            gs.add_chosen(chosen_args{idx, match.node(), index_, 1});
+            ++gs.matchesInside;
+            ++ms.matchesInAlternative;
+        });
+        return conflict;
+    }
+
+    //-----------------------------------------------------
+    /** @brief 'count' matches of a chosen alternative at the same node with
+     *         consecutive ids and arg indices; 'id' counts all arg mappings
+     *         (including discarded ones)
+     */
+    struct chosen_args {
+        std::size_t id;
+        int node;
+        arg_index index;
+        std::size_t count;
+    };
+
+    /** @brief flags arg mappings as conflicting; matches that have already
+     *         been reported are reported again as late conflicts
+     */
+    void flag_conflicts(const chosen_args& c)
+    {
+        for(std::size_t k = 0; k < c.count; ++k) {
+            flag_conflict(c.id + k, c.node, c.index + arg_index(k));
+        }
+    }
+
+    void flag_conflict(std::size_t id, int node, arg_index index)
+    {
+        if(id >= dropped_) {
+            auto& a = args_[id - dropped_];
+            if(a.conflict_) return;
+            a.conflict_ = true;
+        }
+        else {
+            const auto i = std::lower_bound(conflicting_.begin(),
+                                            conflicting_.end(), id);
+            if(i != conflicting_.end() && *i == id) return;
+            conflicting_.insert(i, id);
+        }
+        if(observer_ && id < reported_) {
+            observer_->notify_late_conflict(table()[node].as_param(), index);
+        }
+    }
+
+    //-----------------------------------------------------
+    /** @brief conflict check for speculative matches: only speculative
+     *         matches are flagged, previous matches are left untouched
+     */
+    bool check_speculative_conflicts(const dfs_traverser& match)
+    {
+        if(pos_.start_of_repeat_group()) return false;
+        bool conflict = false;
+        match.for_each_group_on_path([&](int g, int m) {
+            if(!table()[g].exclusive()) return;
+            bool newCycle = false;
+            for(auto i = args_.size(); i > specBegin_ && !newCycle; --i) {
+                auto& a = args_[i-1];
+                //sibling within same exclusive group => conflict
+                if(!a.blocked() && is_alternative_of(a.node_, a.root_, g, m)) {
+                    conflict = true;
+                    a.conflict_ = true;
+                }
+                //check for conflicts only within current repeat cycle
+                newCycle = a.startsRepeatGroup_;
+            }
+            if(!newCycle && alternative_state_of(g).matchesInside >
+                            alternative_state_of(m).matchesInAlternative)
+            {
+                conflict = true;
+            }
+        });
+        return conflict;
+    }
+
+    //-----------------------------------------------------
+    /** @brief matches of alternatives within current repeat cycle */
+    struct alternative_state {
+        explicit
+        alternative_state(detail::memory_resource* res):
+            chosenArgs{detail::make_pooled_vector<chosen_args>(res)}
+        {}
+        std::size_t cycle = 0;
+        //non-blocked matches inside (exclusive) group
+        std::size_t matchesInside = 0;
+        //non-blocked matches inside or at node (as alternative of parent)
+        std::size_t matchesInAlternative = 0;
+        //last chosen alternative (child node) of exclusive group
+        int chosen = -1;
+        //matches of 'chosen' that might need to be flagged
+        detail::pooled_vector<chosen_args> chosenArgs;
+
+        /** @brief runs of consecutive matches are merged, so that the list
+         *         doesn't grow with every argument of e.g. a 'values'
+         *         parameter while arg mappings are streamed
+         */
+        void add_chosen(const chosen_args& c) {
+            if(!chosenArgs.empty()) {
+                auto& l = chosenArgs.back();
+                if(l.node == c.node && l.id + l.count == c.id &&
+                   std::size_t(l.index) + l.count == std::size_t(c.index))
+                {
+                    ++l.count;
+                    return;
+                }
+            }
+            chosenArgs.push_back(c);
+        }
+    };
+
+    alternative_state& alternative_state_of(int n)
+    {
+        if(alternatives_.empty()) {
+            const auto size = std::size_t(table()[root_].end() - root_);
+            alternatives_.reserve(size);
+            for(std::size_t i = 0; i < size; ++i) alternatives_.emplace_back(res_);
+        }
+        auto& s = alternatives_[std::size_t(n - root_)];
+        if(s.cycle != cycle_) {
+            s.cycle = cycle_;
+            s.matchesInside = 0;
+            s.matchesInAlternative = 0;
+            s.chosen = -1;
+            s.chosenArgs.clear();
+        }
+        return s;
+    }
+
+    /** @brief invalidates all alternative states in O(1) */
+    void start_repeat_cycle() noexcept { ++cycle_; }
+
+    //-----------------------------------------------------
+    /** @brief true, if node 'n' (traversed from 'root') is inside
+     *         exclusive group 'g', but not inside g's child 'm'
+     */
+    bool is_alternative_of(int n, int root, int g, int m) const noexcept {
+        return n >= 0 && g >= root && table().inside(n, g) &&
+               !table().inside_or_self(n, m);
     }
 
     //-----------------------------------------------------
     void clean_miss_candidates_for(const dfs_traverser& match)
     {
-        auto i = std::find_if(missCand_.rbegin(), missCand_.rend(),
-            [&](const miss_candidate& m) {
-                return &(*m.pos) == &(*match);
-            });
-
-        if(i != missCand_.rend()) {
-            missCand_.erase(prev(i.base()));
-        }
+        missCand_.erase_last_of(match.node());
     }
 
     //-----------------------------------------------------
     void discard_alternative_miss_candidates(const dfs_traverser& match)
     {
-        if(missCand_.empty()) return;
         //find out, if miss candidate is sibling of one of the same
         //alternative groups that the current match is a member of
         //if so, we can discard the miss
 
-        //go through all exclusive groups of matching pattern
-        for(const auto& m : match.stack()) {
-            if(m.parent->exclusive()) {
-                for(auto i = int(missCand_.size())-1; i >= 0; --i) {
-                    bool removed = false;
-                    for(const auto& c : missCand_[i].pos.stack()) {
-                        //sibling within same exclusive group => discard
-                        if(c.parent == m.parent && c.cur != m.cur) {
-                            missCand_.erase(missCand_.begin() + i);
-                            if(missCand_.empty()) return;
-                            removed = true;
-                            break;
-                        }
-                    }
-                    //remove miss candidates only within current repeat cycle
-                    if(i > 0 && removed) {
-                        if(missCand_[i-1].startsRepeatGroup) break;
-                    } else {
-                        if(missCand_[i].startsRepeatGroup) break;
-                    }
-                }
-            }
+        if(missCand_.empty()) return;
+
+        //children of all exclusive groups on the path to the match
+        group_list alts;
+        match.for_each_group_on_path([&](int g, int m) {
+            if(table()[g].exclusive()) alts.push_back(m);
+        });
+        //outermost group first: discarding stops at the start of the
+        //current repeat cycle, so the order matters
+        for(auto i = alts.rbegin(); i != alts.rend(); ++i) {
+            missCand_.discard_alternatives(table()[*i].parent(), *i);
+            if(missCand_.empty()) return;
         }
     }
 
@@ -4990,13 +8394,13 @@ private:
         //need to add potential misses if:
         //either new repeat group was started
         const auto newRepGroup = match.innermost_repeat_group();
-        if(newRepGroup) {
+        if(newRepGroup >= 0) {
             if(pos_.start_of_repeat_group()) {
                 for_each_potential_miss(std::move(npos),
                     [&,this](const dfs_traverser& pos) {
                         //only add candidates within repeat group
                         if(newRepGroup == pos.innermost_repeat_group()) {
-                            missCand_.emplace_back(pos, index_, true);
+                            missCand_.push_back(pos, index_, true);
                         }
                     });
             }
@@ -5008,12 +8412,8 @@ private:
             for_each_potential_miss(std::move(npos),
                 [&,this](const dfs_traverser& pos) {
                     //only add new candidates
-                    if(std::find_if(missCand_.begin(), missCand_.end(),
-                        [&](const miss_candidate& c){
-                            return &(*c.pos) == &(*pos);
-                        }) == missCand_.end())
-                    {
-                        missCand_.emplace_back(pos, index_);
+                    if(!missCand_.contains(pos.node())) {
+                        missCand_.push_back(pos, index_);
                     }
                 });
         }
@@ -5049,26 +8449,56 @@ private:
 
 
     //---------------------------------------------------------------
-    std::size_t occurrences_of(const parameter* p) const
+    /** @brief number of previous matches of parameter node 'n' */
+    std::size_t occurrences_of(int n) const noexcept
     {
-        if(!p) return 0;
-
-        auto i = std::find_if(args_.rbegin(), args_.rend(),
-            [p](const arg_mapping& a){ return a.param() == p; });
+        const auto i = std::size_t(n - root_);
+        return i < occurrences_.size() ? occurrences_[i] : 0;
+    }
 
-        if(i != args_.rend()) return i->repeat() + 1;
-        return 0;
+    //---------------------------------------------------------------
+    /** @brief records new arg mapping in per-node occurrence counters */
+    void count_occurrence(const arg_mapping& a)
+    {
+        if(a.node_ < 0) return;
+        if(occurrences_.empty()) {
+            occurrences_.resize(std::size_t(table()[root_].end() - root_), 0);
+        }
+        occurrences_[std::size_t(a.node_ - root_)] = a.repeat_ + 1;
     }
 
 
     //---------------------------------------------------------------
-    const group* root_;
+    compiled_cli cli_;
+    int root_;
     scoped_dfs_traverser pos_;
     arg_index index_;
     arg_index eaten_;
+    detail::memory_resource* res_;
     arg_mappings args_;
     miss_candidates missCand_;
+    //state of 'missCand_' after construction; made by first 'reset'
+    miss_candidates initialMissCand_;
+    bool hasSnapshot_;
+    //number of matches per parameter node (relative to root node)
+    detail::pooled_vector<std::size_t> occurrences_;
+    //matches of alternatives per node (relative to root node)
+    detail::pooled_vector<alternative_state> alternatives_;
+    //arg mappings made for the whole argument currently being processed
+    detail::pooled_vector<std::size_t> wholeArgs_;
+    std::size_t cycle_;
+    //index of first arg mapping made during speculative matching
+    std::size_t specBegin_;
+    const observer* observer_;
+    //number of discarded arg mappings (that preceded 'args_')
+    std::size_t dropped_;
+    //sorted ids of discarded arg mappings that were flagged as conflicting
+    detail::pooled_vector<std::size_t> conflicting_;
+    //number of arg mappings passed to the observer
+    std::size_t reported_;
+    bool retainArgs_;
     bool blocked_;
+    bool speculative_;
 };
 
 
@@ -5160,8 +8590,46 @@ private:
 
 
 namespace detail {
+
+struct arg_mapping_access {
+    /** @brief index of the matched node within the compiled table */
+    static int node(const parser::arg_mapping& m) noexcept { return m.node_; }
+};
+
 namespace {
 
+/*************************************************************************//**
+ *
+ * @brief corrects argument 'arg' using its predecessor 'prv'
+ *        e.g. {"-o12", ".34"} -> {"-o", "12.34"}
+ *
+ *****************************************************************************/
+void sanitize_arg_pair(arg_string& prv, arg_string& arg)
+{
+    if(arg.size() > 1 && arg.find('.') == 0 && std::isdigit(arg[1]) ) {
+        //find trailing digits in previous arg
+        auto fstDigit = std::find_if_not(prv.rbegin(), prv.rend(),
+            [](arg_string::value_type c){
+                return std::isdigit(c);
+            }).base();
+
+        //handle leading sign
+        if(fstDigit > prv.begin() &&
+            (*std::prev(fstDigit) == '+' || *std::prev(fstDigit) == '-'))
+        {
+            --fstDigit;
+        }
+
+        //prepend digits from previous arg
+        arg.insert(begin(arg), fstDigit, end(prv));
+
+        //erase digits in previous arg
+        prv.erase(fstDigit, end(prv));
+    }
+}
+
+
+
 /*************************************************************************//**
  *
  * @brief correct some common problems
@@ -5171,35 +8639,10 @@ namespace {
  *****************************************************************************/
 void sanitize_args(arg_list& args)
 {
-    //e.g. {"-o12", ".34"} -> {"-o", "12.34"}
-
     if(args.empty()) return;
 
     for(auto i = begin(args)+1; i != end(args); ++i) {
-        if(i != begin(args) && i->size() > 1 &&
-            i->find('.') == 0 && std::isdigit((*i)[1]) )
-        {
-            //find trailing digits in previous arg
-            using std::prev;
-            auto& prv = *prev(i);
-            auto fstDigit = std::find_if_not(prv.rbegin(), prv.rend(),
-                [](arg_string::value_type c){
-                    return std::isdigit(c);
-                }).base();
-
-            //handle leading sign
-            if(fstDigit > prv.begin() &&
-                (*prev(fstDigit) == '+' || *prev(fstDigit) == '-'))
-            {
-                --fstDigit;
-            }
-
-            //prepend digits from previous arg
-            i->insert(begin(*i), fstDigit, end(prv));
-
-            //erase digits in previous arg
-            prv.erase(fstDigit, end(prv));
-        }
+        sanitize_arg_pair(*std::prev(i), *i);
     }
 }
 
@@ -5207,22 +8650,48 @@ void sanitize_args(arg_list& args)
 
 /*************************************************************************//**
  *
- * @brief executes actions based on a parsing result
+ * @brief executes actions based on an arg mapping or a parsing result
  *
  *****************************************************************************/
-void execute_actions(const parsing_result& res)
+void execute_actions(const parser::arg_mapping& m)
 {
-    for(const auto& m : res) {
-        if(m.param()) {
-            const auto& param = *(m.param());
+    if(m.param()) {
+        const auto& param = *(m.param());
 
-            if(m.repeat() > 0) param.notify_repeated(m.index());
-            if(m.blocked())    param.notify_blocked(m.index());
-            if(m.conflict())   param.notify_conflict(m.index());
-            //main action
-            if(!m.any_error()) param.execute_actions(m.arg());
+        if(m.repeat() > 0) param.notify_repeated(m.index());
+        if(m.blocked())    param.notify_blocked(m.index());
+        if(m.conflict())   param.notify_conflict(m.index());
+        //main action
+        if(!m.any_error()) param.execute_actions(m.arg(), m.scanned());
+    }
+}
+
+/** @brief lets container targets reserve space for all values
+ *         of a parsing result before they are converted and appended */
+void reserve_targets(const parsing_result& res)
+{
+    //matches are counted per node of the compiled table
+    std::vector<std::pair<const parameter*,std::size_t>> counts;
+    for(const auto& m : res) {
+        if(m.param() && !m.any_error() && m.param()->reserves_targets()) {
+            const auto n = std::size_t(arg_mapping_access::node(m));
+            if(n >= counts.size()) counts.resize(n + 1);
+            counts[n].first = m.param();
+            ++counts[n].second;
         }
     }
+    for(const auto& c : counts) {
+        if(c.second > 0) c.first->reserve_targets(c.second);
+    }
+}
+
+void execute_actions(const parsing_result& res)
+{
+    reserve_targets(res);
+
+    for(const auto& m : res) {
+        execute_actions(m);
+    }
 
     for(auto m : res.missing()) {
         if(m.param()) m.param()->notify_missing(m.after_index());
@@ -5236,18 +8705,40 @@ void execute_actions(const parsing_result& res)
  * @brief parses input args
  *
  *****************************************************************************/
-static parsing_result
-parse_args(const arg_list& args, const group& cli,
-           arg_index offset = 0)
+static void
+process_args(arg_list args, parser& parse)
 {
     //parse args and store unrecognized arg indices
-    parser parse{cli, offset};
-    for(const auto& arg : args) {
-        parse(arg);
+    for(auto& arg : args) {
+        parse(std::move(arg));
         if(!parse.valid()) break;
     }
+}
+
+/** @brief reusable parser keeps the buffer of its arg mappings */
+static parsing_result
+parse_args(arg_list args, parser& parse)
+{
+    process_args(std::move(args), parse);
 
-    return parsing_result{parse.args(), parse.missed()};
+    auto misses = parse.missed();
+    return parsing_result{parse.extract_args(), std::move(misses)};
+}
+
+static parsing_result
+parse_args(arg_list args, const compiled_cli& cli,
+           arg_index offset = 0, memory_resource* res = nullptr)
+{
+#ifdef CLIPP_HAS_PMR
+    parser parse{cli, res, offset};
+#else
+    (void)res;
+    parser parse{cli, offset};
+#endif
+    process_args(std::move(args), parse);
+
+    auto misses = parse.missed();
+    return parsing_result{std::move(parse).args(), std::move(misses)};
 }
 
 /*************************************************************************//**
@@ -5256,16 +8747,182 @@ parse_args(const arg_list& args, const group& cli,
  *
  *****************************************************************************/
 static parsing_result
-parse_and_execute(const arg_list& args, const group& cli,
-                  arg_index offset = 0)
+parse_and_execute(arg_list args, const compiled_cli& cli,
+                  arg_index offset = 0, memory_resource* res = nullptr)
+{
+    auto result = parse_args(std::move(args), cli, offset, res);
+
+    execute_actions(result);
+
+    return result;
+}
+
+static parsing_result
+parse_and_execute(arg_list args, parser& parse)
 {
-    auto result = parse_args(args, cli, offset);
+    auto result = parse_args(std::move(args), parse);
 
     execute_actions(result);
 
     return result;
 }
 
+
+
+/*************************************************************************//**
+ *
+ * @brief parses args one at a time & executes actions as soon as an
+ *        argument has been processed; arg mappings are not retained
+ *
+ *****************************************************************************/
+class streaming_parser
+{
+public:
+    explicit
+    streaming_parser(const compiled_cli& cli, const parser::observer& obs,
+                     arg_index offset)
+    :
+        parse_{cli, offset}, obs_{obs}
+    {
+        exec_.on_match([this](const parser::arg_mapping& m) {
+                if(m.any_error()) ok_ = false;
+                execute_actions(m);
+                obs_.notify_match(m);
+            })
+            .on_late_conflict([this](const parameter& p, arg_index idx) {
+                ok_ = false;
+                p.notify_conflict(idx);
+                obs_.notify_late_conflict(p, idx);
+            });
+        parse_.observe(&exec_, false);
+    }
+
+    streaming_parser(const streaming_parser&) = delete;
+    streaming_parser& operator = (const streaming_parser&) = delete;
+
+    /** @brief false, if no more arguments will be processed */
+    bool valid() const noexcept { return !done_; }
+
+    /** @brief processes the previous argument; each argument is held back
+     *         until its successor is known, because it might need to be
+     *         corrected (see 'sanitize_args')
+     */
+    void operator() (arg_string arg)
+    {
+        if(done_) return;
+        if(pending_) {
+            sanitize_arg_pair(prv_, arg);
+            parse_(std::move(prv_));
+            if(!parse_.valid()) {
+                pending_ = false;
+                done_ = true;
+                return;
+            }
+        }
+        prv_ = std::move(arg);
+        pending_ = true;
+    }
+
+    /** @brief processes last argument & reports missing parameters
+     *  @return true, if no parsing error occurred
+     */
+    bool finish()
+    {
+        if(pending_) parse_(std::move(prv_));
+        pending_ = false;
+        done_ = true;
+
+        for(const auto& m : parse_.missed()) {
+            ok_ = false;
+            if(m.param()) {
+                m.param()->notify_missing(m.after_index());
+                obs_.notify_missing(*m.param(), m.after_index());
+            }
+        }
+        return ok_;
+    }
+
+private:
+    parser parse_;
+    const parser::observer& obs_;
+    parser::observer exec_;
+    arg_string prv_;
+    bool pending_ = false;
+    bool done_ = false;
+    bool ok_ = true;
+};
+
+
+
+/*************************************************************************//**
+ *
+ * @brief reads the next argument from a response file; arguments are
+ *        separated by whitespace, can be quoted with '...' or "..." and
+ *        any character can be escaped with a backslash
+ *
+ * @return false, if there are no more arguments
+ *
+ *****************************************************************************/
+bool read_response_arg(std::streambuf& in, arg_string& arg)
+{
+    using traits = std::streambuf::traits_type;
+    const auto eof = traits::eof();
+
+    arg.clear();
+    auto c = in.sgetc();
+    while(c != eof && std::isspace(c)) c = in.snextc();
+    if(c == eof) return false;
+
+    char quote = 0;
+    for(; c != eof; c = in.snextc()) {
+        const auto ch = traits::to_char_type(c);
+        if(ch == '\\') {
+            c = in.snextc();
+            if(c == eof) break;
+            arg += traits::to_char_type(c);
+        }
+        else if(quote) {
+            if(ch == quote) quote = 0; else arg += ch;
+        }
+        else if(std::isspace(c)) {
+            break;
+        }
+        else if(ch == '\'' || ch == '"') {
+            quote = ch;
+        }
+        else {
+            arg += ch;
+        }
+    }
+    return true;
+}
+
+
+
+/*************************************************************************//**
+ *
+ * @brief passes argument to 'parse'; an argument "@file" is replaced by
+ *        the arguments read from 'file' (if it can be opened)
+ *
+ *****************************************************************************/
+void parse_expanded(arg_string arg, streaming_parser& parse, int depth = 0)
+{
+    //response files may refer to other response files
+    constexpr int maxDepth = 16;
+
+    if(arg.size() > 1 && arg.front() == '@' && depth < maxDepth) {
+        std::ifstream file{arg.substr(1)};
+        if(file) {
+            arg_string a;
+            while(parse.valid() && read_response_arg(*file.rdbuf(), a)) {
+                parse_expanded(std::move(a), parse, depth + 1);
+            }
+            return;
+        }
+    }
+    parse(std::move(arg));
+}
+
 } //anonymous namespace
 } // namespace detail
 
@@ -5278,10 +8935,38 @@ parse_and_execute(const arg_list& args, const group& cli,
  *
  *****************************************************************************/
 inline parsing_result
+parse(arg_list args, const compiled_cli& cli)
+{
+    detail::sanitize_args(args);
+    return detail::parse_and_execute(std::move(args), cli);
+}
+
+/** @brief same as above, but 'cli' is compiled for this call only:
+ *         building the node table, flag index and trie takes time and
+ *         allocations proportional to the size of the interface;
+ *         if an interface is parsed more than once, 'compile' it once
+ *         (or use a reusable 'parser') and pass the 'compiled_cli' instead
+ */
+inline parsing_result
 parse(arg_list args, const group& cli)
+{
+    return parse(std::move(args), compiled_cli{cli});
+}
+
+
+/*************************************************************************//**
+ *
+ * @brief parses vector of arg strings and executes actions using a
+ *        reusable parser which is reset first; repeated calls don't have
+ *        to set up the parser state from scratch
+ *
+ *****************************************************************************/
+inline parsing_result
+parse(arg_list args, parser& p, arg_index offset = 0)
 {
     detail::sanitize_args(args);
-    return detail::parse_and_execute(args, cli);
+    p.reset(offset);
+    return detail::parse_and_execute(std::move(args), p);
 }
 
 
@@ -5291,7 +8976,7 @@ parse(arg_list args, const group& cli)
  *
  *****************************************************************************/
 inline parsing_result
-parse(std::initializer_list<const char*> arglist, const group& cli)
+parse(std::initializer_list<const char*> arglist, const compiled_cli& cli)
 {
     arg_list args;
     args.reserve(arglist.size());
@@ -5302,6 +8987,13 @@ parse(std::initializer_list<const char*> arglist, const group& cli)
     return parse(std::move(args), cli);
 }
 
+/** @brief compiles 'cli' for this call only (see 'parse(arg_list,group)') */
+inline parsing_result
+parse(std::initializer_list<const char*> arglist, const group& cli)
+{
+    return parse(arglist, compiled_cli{cli});
+}
+
 
 /*************************************************************************//**
  *
@@ -5310,11 +9002,19 @@ parse(std::initializer_list<const char*> arglist, const group& cli)
  *****************************************************************************/
 template<class InputIterator>
 inline parsing_result
-parse(InputIterator first, InputIterator last, const group& cli)
+parse(InputIterator first, InputIterator last, const compiled_cli& cli)
 {
     return parse(arg_list(first,last), cli);
 }
 
+/** @brief compiles 'cli' for this call only (see 'parse(arg_list,group)') */
+template<class InputIterator>
+inline parsing_result
+parse(InputIterator first, InputIterator last, const group& cli)
+{
+    return parse(arg_list(first,last), compiled_cli{cli});
+}
+
 
 /*************************************************************************//**
  *
@@ -5322,13 +9022,146 @@ parse(InputIterator first, InputIterator last, const group& cli)
  *
  *****************************************************************************/
 inline parsing_result
+parse(const int argc, char* argv[], const compiled_cli& cli,
+      arg_index offset = 1)
+{
+    arg_list args;
+    if(offset < argc) args.assign(argv+offset, argv+argc);
+    detail::sanitize_args(args);
+    return detail::parse_and_execute(std::move(args), cli, offset);
+}
+
+/** @brief compiles 'cli' for this call only (see 'parse(arg_list,group)') */
+inline parsing_result
 parse(const int argc, char* argv[], const group& cli, arg_index offset = 1)
+{
+    return parse(argc, argv, compiled_cli{cli}, offset);
+}
+
+
+
+/*************************************************************************//**
+ *
+ * @brief parses range of arg strings one at a time and executes actions
+ *        as soon as an argument has been processed; all parsing events
+ *        are also passed to 'obs';
+ *        arg mappings are not kept, so that memory use doesn't grow with
+ *        the number of arguments (e.g. when reading arguments from a
+ *        stream); note that actions of an argument are executed even if
+ *        a later argument turns out to conflict with it
+ *
+ * @return true, if no parsing error occurred
+ *
+ *****************************************************************************/
+template<class InputIterator>
+inline bool
+stream_parse(InputIterator first, InputIterator last, const compiled_cli& cli,
+             const parser::observer& obs = parser::observer{},
+             arg_index offset = 0)
+{
+    detail::streaming_parser parse{cli, obs, offset};
+    for(; first != last && parse.valid(); ++first) {
+        parse(arg_string(*first));
+    }
+    return parse.finish();
+}
+
+template<class InputIterator>
+inline bool
+stream_parse(InputIterator first, InputIterator last, const group& cli,
+             const parser::observer& obs = parser::observer{},
+             arg_index offset = 0)
+{
+    return stream_parse(first, last, compiled_cli{cli}, obs, offset);
+}
+
+
+
+/*************************************************************************//**
+ *
+ * @brief same as 'stream_parse', but each argument "@file" is replaced by
+ *        the arguments read from response file 'file';
+ *        file arguments are separated by whitespace, can be quoted with
+ *        '...' or "..." and characters can be escaped with a backslash;
+ *        response files are read in chunks and their arguments are passed
+ *        to the parser one at a time, so that the memory use doesn't
+ *        depend on the file size; an argument "@file" is kept if 'file'
+ *        can't be opened
+ *
+ * @return true, if no parsing error occurred
+ *
+ *****************************************************************************/
+template<class InputIterator>
+inline bool
+stream_parse_expanded(InputIterator first, InputIterator last,
+                      const compiled_cli& cli,
+                      const parser::observer& obs = parser::observer{},
+                      arg_index offset = 0)
+{
+    detail::streaming_parser parse{cli, obs, offset};
+    for(; first != last && parse.valid(); ++first) {
+        detail::parse_expanded(arg_string(*first), parse);
+    }
+    return parse.finish();
+}
+
+template<class InputIterator>
+inline bool
+stream_parse_expanded(InputIterator first, InputIterator last,
+                      const group& cli,
+                      const parser::observer& obs = parser::observer{},
+                      arg_index offset = 0)
+{
+    return stream_parse_expanded(first, last, compiled_cli{cli}, obs, offset);
+}
+
+/** @brief omits argv[0] */
+inline bool
+stream_parse_expanded(const int argc, char* argv[], const compiled_cli& cli,
+                      const parser::observer& obs = parser::observer{},
+                      arg_index offset = 1)
+{
+    return offset < argc
+        ? stream_parse_expanded(argv+offset, argv+argc, cli, obs, offset)
+        : stream_parse_expanded(argv, argv, cli, obs, offset);
+}
+
+inline bool
+stream_parse_expanded(const int argc, char* argv[], const group& cli,
+                      const parser::observer& obs = parser::observer{},
+                      arg_index offset = 1)
+{
+    return stream_parse_expanded(argc, argv, compiled_cli{cli}, obs, offset);
+}
+
+
+
+#ifdef CLIPP_HAS_PMR
+/*************************************************************************//**
+ *
+ * @brief parses vector of arg strings or the standard array of command
+ *        line arguments (omitting argv[0]) and executes actions;
+ *        parser state and the result's containers are allocated from
+ *        memory resource 'res' which must outlive the result
+ *
+ *****************************************************************************/
+inline parsing_result
+parse(arg_list args, const compiled_cli& cli, std::pmr::memory_resource* res)
+{
+    detail::sanitize_args(args);
+    return detail::parse_and_execute(std::move(args), cli, 0, res);
+}
+
+inline parsing_result
+parse(const int argc, char* argv[], const compiled_cli& cli,
+      std::pmr::memory_resource* res, arg_index offset = 1)
 {
     arg_list args;
     if(offset < argc) args.assign(argv+offset, argv+argc);
     detail::sanitize_args(args);
-    return detail::parse_and_execute(args, cli, offset);
+    return detail::parse_and_execute(std::move(args), cli, offset, res);
 }
+#endif
 
 
 
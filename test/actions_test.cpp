@@ -110,6 +110,39 @@ void test(int lineNo,
 }
 
 
+//-------------------------------------------------------------------
+void test_storage(int lineNo)
+{
+    using namespace clipp;
+
+    //small and large callables, executed in the order they were added
+    std::string log;
+    const std::array<char,64> big {{'b'}};
+    int calls = 0;
+
+    auto p = option("-p")
+        .call([&]{ log += 's'; })
+        .call([&log,big](const char* a){ log += big[0]; log += a; })
+        .call([&log,calls]() mutable { log += char('0' + ++calls); })
+        .if_repeated([&log,big](int i){ log += big[0] + std::to_string(i); })
+        .if_conflicted([&]{ log += 'c'; });
+
+    //copies own their actions (and their state)
+    auto q = p;
+
+    const auto cli1 = group( repeatable(p) );
+    const auto cli2 = group( q.call([&]{ log += 'q'; }) );
+
+    const auto ok1 = parse({"-p", "-p"}, cli1);
+    const auto ok2 = parse({"-p"}, cli2);
+
+    if(!ok1 || !ok2 || log != "sb-p1b1sb-p2" "sb-p1q") {
+        throw std::runtime_error{"failed test " + std::string(__FILE__) +
+                                 " in line " + std::to_string(lineNo)};
+    }
+}
+
+
 //-------------------------------------------------------------------
 int main()
 {
@@ -394,6 +427,7 @@ int main()
               counts{0,0, 0,0,0, 0,0,0, 0,0, 0, 0, 0,0, 0,0, 0,0}, /*conflicts*/
               counts{0,0, 0,0,0, 0,0,0, 0,0, 0, 0, 0,0, 0,0, 0,0}  /*repeats*/);
 
+        test_storage(__LINE__);
     }
     catch(std::exception& e) {
         std::cerr << e.what() << std::endl;
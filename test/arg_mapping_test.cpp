@@ -0,0 +1,70 @@
+/*****************************************************************************
+ *
+ * CLIPP - command line interfaces for modern C++
+ *
+ * released under MIT license
+ *
+ * (c) 2017-2018 André Müller; foss@andremueller-online.de
+ *
+ * Tests: arguments (or parts of joined arguments) stored in
+ *        argument -> parameter mappings and passed to actions
+ *
+ *****************************************************************************/
+
+#include "testing.h"
+
+
+//-------------------------------------------------------------------
+void test(int lineNo,
+          const std::initializer_list<const char*> args,
+          const std::vector<std::string>& expected)
+{
+    using namespace clipp;
+
+    std::vector<std::string> m;
+    const auto arg = [&](const char* s) { m.push_back(s); };
+
+    //whole arguments, joined flags and flags with attached values
+    auto cli = (
+        command("run").call(arg),
+        joinable(option("-a").call(arg), option("-b").call(arg)),
+        option("-n").call(arg) & integer("n").call(arg),
+        option("-o").call(arg) & value("out").call(arg),
+        values("file").call(arg)
+    );
+
+    run_test({ __FILE__, lineNo }, args, cli,
+             [&]{ return m == expected; });
+}
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        test(__LINE__, {}, {});
+        test(__LINE__, {"run", "f"}, {"run", "f"});
+        test(__LINE__, {"run", "-ab", "f"}, {"run", "-a", "-b", "f"});
+        test(__LINE__, {"run", "-ba", "-n", "12", "f"},
+                       {"run", "-b", "-a", "-n", "12", "f"});
+
+        test(__LINE__, {"run", "-n12", "f"}, {"run", "-n", "12", "f"});
+        test(__LINE__, {"run", "-ofile", "f"}, {"run", "-o", "file", "f"});
+        test(__LINE__, {"run", "-o", "file", "-ab", "f", "g"},
+                       {"run", "-o", "file", "-a", "-b", "f", "g"});
+
+        //no valid split => whole argument
+        test(__LINE__, {"run", "-n1x", "f"}, {"run", "-n1x", "f"});
+
+        //large arguments are passed on unchanged
+        const std::string big (1 << 20, 'x');
+        test(__LINE__, {"run", big.c_str()}, {"run", big});
+        test(__LINE__, {"run", "-o", big.c_str(), "f"}, {"run", "-o", big, "f"});
+        test(__LINE__, {"run", ("-o" + big).c_str(), "f"},
+                       {"run", "-o", big, "f"});
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
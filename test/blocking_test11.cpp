@@ -0,0 +1,91 @@
+/*****************************************************************************
+ *
+ * CLIPP - command line interfaces for modern C++
+ *
+ * released under MIT license
+ *
+ * (c) 2017-2018 André Müller; foss@andremueller-online.de
+ *
+ * Tests: position after a match inside a repeatable group that follows
+ *        a joinable group with a greedy, blocking value
+ *
+ *****************************************************************************/
+
+#include "testing.h"
+
+
+//-------------------------------------------------------------------
+struct active {
+    active() = default;
+    explicit
+    active(std::vector<std::string> a_, std::vector<std::string> b_,
+           std::vector<int> ra_, std::vector<int> rb_)
+    :
+        a{std::move(a_)}, b{std::move(b_)},
+        ra{std::move(ra_)}, rb{std::move(rb_)}
+    {}
+
+    //matched values
+    std::vector<std::string> a, b;
+    //indices of repeated arguments
+    std::vector<int> ra, rb;
+
+    friend bool operator == (const active& x, const active& y) noexcept {
+        return x.a == y.a && x.b == y.b && x.ra == y.ra && x.rb == y.rb;
+    }
+};
+
+
+//-------------------------------------------------------------------
+void test(int lineNo,
+          const std::initializer_list<const char*> args,
+          const active& matches)
+{
+    using namespace clipp;
+
+    active m;
+
+    auto cli = (
+        joinable(
+            value("a").blocking(true).greedy(true)
+                .call([&](const char* s){ m.a.push_back(s); })
+                .if_repeated([&](int i){ m.ra.push_back(i); }),
+            required("-a")
+        ),
+        (
+            group(
+                values("b").repeatable(false)
+                    .call([&](const char* s){ m.b.push_back(s); })
+                    .if_repeated([&](int i){ m.rb.push_back(i); }),
+                option("y").repeatable(true).blocking(true)
+            ).repeatable(true),
+            command("-ab")
+        )
+    ) | command("-ab");
+
+    run_wrapped_variants({ __FILE__, lineNo }, args, cli,
+              [&]{ m = active{}; },
+              [&]{ return m == matches; });
+}
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        test(__LINE__, {"x12"}, active{{"x12"}, {}, {}, {}});
+        test(__LINE__, {"x12", "y"}, active{{"x12"}, {"y"}, {}, {}});
+
+        //"12.5" is a (bad) repeat of "a"
+        test(__LINE__, {"x12", "y", "12.5"},
+                       active{{"x12"}, {"y"}, {2}, {}});
+
+        //"12" is a repeat of "b"
+        test(__LINE__, {"x12", "y", "12.5", "12"},
+                       active{{"x12"}, {"y", "12"}, {2}, {3}});
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,109 @@
+/*****************************************************************************
+ *
+ * CLIPP - command line interfaces for modern C++
+ *
+ * released under MIT license
+ *
+ * (c) 2017-2018 André Müller; foss@andremueller-online.de
+ *
+ * Tests: parsing with a compiled (flattened) command line interface
+ *        must yield the same results as parsing with the original group;
+ *        one compiled interface can be used for many parse calls
+ *
+ *****************************************************************************/
+
+#include "testing.h"
+
+
+//-------------------------------------------------------------------
+struct active {
+    active() = default;
+    explicit
+    active(bool v_, bool b_, int j_, bool r_, bool d_,
+           std::vector<std::string> t_, bool c_, bool all_)
+    :
+        v{v_}, b{b_}, j{j_}, r{r_}, d{d_}, t{std::move(t_)},
+        c{c_}, all{all_}
+    {}
+
+    bool v = false, b = false;
+    int j = 0;
+    bool r = false, d = false;
+    std::vector<std::string> t;
+    bool c = false, all = false;
+
+    friend bool operator == (const active& x, const active& y) noexcept {
+        return (x.v == y.v && x.b == y.b && x.j == y.j && x.r == y.r &&
+                x.d == y.d && x.t == y.t && x.c == y.c && x.all == y.all);
+    }
+};
+
+
+//-------------------------------------------------------------------
+void test(int lineNo,
+          const std::initializer_list<const char*> args,
+          const active& matches)
+{
+    using namespace clipp;
+
+    active m;
+
+    //alternatives and sequences on different nesting levels
+    auto cli = (
+        option("-v").set(m.v),
+        (
+            command("build").set(m.b),
+            (option("-j") & integer("jobs", m.j)),
+            (option("--release").set(m.r) | option("--debug").set(m.d)),
+            values("targets", m.t)
+        ) | (
+            command("clean").set(m.c),
+            option("--all").set(m.all)
+        )
+    );
+
+    run_wrapped_variants({ __FILE__, lineNo }, args, cli,
+              [&]{ m = active{}; },
+              [&]{ return m == matches; });
+
+    //one compiled interface for several parse calls
+    const auto compiled = compile(cli);
+    for(int i = 0; i < 3; ++i) {
+        m = active{};
+        run_test({ __FILE__, lineNo }, args, compiled,
+                 [&]{ return m == matches; });
+    }
+}
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        test(__LINE__, {}, active{});
+
+        test(__LINE__, {"-v"}, active{1,0,0,0,0,{},0,0});
+        test(__LINE__, {"-v", "build"}, active{1,1,0,0,0,{},0,0});
+        test(__LINE__, {"build", "-v"}, active{1,1,0,0,0,{},0,0});
+
+        test(__LINE__, {"build", "-j", "4", "--release", "a", "b"},
+                       active{0,1,4,1,0,{"a","b"},0,0});
+
+        test(__LINE__, {"build", "--debug", "a", "b"},
+                       active{0,1,0,0,1,{"a","b"},0,0});
+
+        test(__LINE__, {"build", "--debug", "-j", "2"},
+                       active{0,1,2,0,1,{},0,0});
+
+        //'--debug' is taken as target
+        test(__LINE__, {"build", "a", "--debug"},
+                       active{0,1,0,0,0,{"a","--debug"},0,0});
+
+        test(__LINE__, {"clean", "--all", "-v"}, active{1,0,0,0,0,{},1,1});
+        test(__LINE__, {"clean"}, active{0,0,0,0,0,{},1,0});
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
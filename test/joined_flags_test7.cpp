@@ -0,0 +1,66 @@
+/*****************************************************************************
+ *
+ * CLIPP - command line interfaces for modern C++
+ *
+ * released under MIT license
+ *
+ * (c) 2017-2018 André Müller; foss@andremueller-online.de
+ *
+ *****************************************************************************/
+
+#include "testing.h"
+
+
+//-------------------------------------------------------------------
+struct active {
+    active() = default;
+    active(bool a_, bool b_, const std::string& n_, const std::string& w_):
+        a{a_}, b{b_}, n{n_}, w{w_}
+    {}
+    bool a = false, b = false;
+    std::string n, w;
+
+    friend bool operator == (const active& x, const active& y) noexcept {
+        return (x.a == y.a && x.b == y.b && x.n == y.n && x.w == y.w);
+    }
+};
+
+
+//-------------------------------------------------------------------
+void test(int lineNo,
+          const std::initializer_list<const char*> args,
+          const active& matches)
+{
+    using namespace clipp;
+    active m;
+
+    //joinable group that starts with a (blocking) command
+    auto cli =  (
+        joinable(command("x").set(m.a),
+                 option("y").set(m.b),
+                 option("z") & value("n", m.n)),
+        value("w", m.w)  );
+
+    run_wrapped_variants({ __FILE__, lineNo }, args, cli,
+              [&]{ m = active{}; },
+              [&]{ return m == matches; });
+}
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        test(__LINE__, {"x"},             active{1,0,"",""});
+        test(__LINE__, {"xy"},            active{1,1,"",""});
+        test(__LINE__, {"x","y","w"},     active{1,1,"","w"});
+        test(__LINE__, {"x","z-","w"},    active{1,0,"-","w"});
+        //join group must still be found after the last parameter
+        test(__LINE__, {"x","z-","w","xy"}, active{1,1,"-","w"});
+        test(__LINE__, {"x","z-","1","xy"}, active{1,1,"-","1"});
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
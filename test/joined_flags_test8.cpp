@@ -0,0 +1,68 @@
+/*****************************************************************************
+ *
+ * CLIPP - command line interfaces for modern C++
+ *
+ * released under MIT license
+ *
+ * (c) 2017-2018 André Müller; foss@andremueller-online.de
+ *
+ *****************************************************************************/
+
+#include "testing.h"
+
+
+//-------------------------------------------------------------------
+struct counts {
+    counts() = default;
+    counts(int ob_, int d_, int a_, int ib_, int r_):
+        ob{ob_}, d{d_}, a{a_}, ib{ib_}, r{r_}
+    {}
+    int ob = 0, d = 0, a = 0, ib = 0, r = 0;
+
+    friend bool operator == (const counts& x, const counts& y) noexcept {
+        return (x.ob == y.ob && x.d == y.d && x.a == y.a &&
+                x.ib == y.ib && x.r == y.r);
+    }
+};
+
+
+//-------------------------------------------------------------------
+void test(int lineNo,
+          const std::initializer_list<const char*> args,
+          const counts& matches)
+{
+    using namespace clipp;
+    counts m;
+
+    //blocking flag inside a joinable group;
+    //the position after a joined match must lead back to the outer flag
+    auto cli = (
+        option("-b").call([&]{ ++m.ob; }).if_repeated([&]{ ++m.r; }),
+        joinable(
+            group(option("-").call([&]{ ++m.d; }).if_repeated([&]{ ++m.r; }),
+                  option("--a").blocking(true).call([&]{ ++m.a; })
+                               .if_repeated([&]{ ++m.r; }),
+                  value("v").required(false)),
+            option("b").call([&]{ ++m.ib; }).if_repeated([&]{ ++m.r; })
+        ) );
+
+    run_wrapped_variants({ __FILE__, lineNo }, args, cli,
+              [&]{ m = counts{}; },
+              [&]{ return m == matches; });
+}
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        test(__LINE__, {"--ab"},        counts{0,0,1,1,0});
+        test(__LINE__, {"-b"},          counts{1,0,0,0,0});
+        test(__LINE__, {"--ab","-b"},   counts{1,0,1,1,0});
+        test(__LINE__, {"-b","--ab"},   counts{1,0,1,1,0});
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,117 @@
+/*****************************************************************************
+ *
+ * CLIPP - command line interfaces for modern C++
+ *
+ * released under MIT license
+ *
+ * (c) 2017-2018 André Müller; foss@andremueller-online.de
+ *
+ *****************************************************************************/
+
+#include "testing.h"
+
+#include <cstdlib>
+#include <new>
+
+
+//-------------------------------------------------------------------
+// counts heap bytes allocated by the parser
+//-------------------------------------------------------------------
+static std::size_t allocated = 0;
+
+void* operator new(std::size_t n)
+{
+    allocated += n;
+    if(auto p = std::malloc(n)) return p;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+#if __cplusplus >= 201402L
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+#endif
+
+
+//-------------------------------------------------------------------
+/** @brief matches up to and including the next comma;
+ *         also accepts character ranges, so it can match in place */
+struct up_to_comma {
+    clipp::subrange operator () (const std::string& s) const {
+        return (*this)(s.data(), s.data() + s.size());
+    }
+    clipp::subrange operator () (const char* first, const char* last) const {
+        auto i = std::find(first, last, ',');
+        if(i != last) ++i;
+        if(i == first) return clipp::subrange{};
+        return clipp::subrange{0, std::size_t(i - first)};
+    }
+};
+
+
+//-------------------------------------------------------------------
+std::string long_arg(int n)
+{
+    std::string a = "-X";
+    for(int i = 0; i < n; ++i) a += "key" + std::to_string(i) + "=v,";
+    return a;
+}
+
+
+//-------------------------------------------------------------------
+/** @brief heap bytes allocated by parsing a joined sequence of 'n' values */
+template<class CLI>
+std::size_t
+bytes_allocated(int lineNo, const CLI& cli, std::vector<std::string>& kv, int n)
+{
+    const auto args = clipp::arg_list{long_arg(n)};
+    kv.clear();
+    kv.shrink_to_fit();
+
+    allocated = 0;
+    const bool ok = bool(clipp::parse(args, cli));
+    const auto bytes = allocated;
+
+    if(!ok || kv.size() != std::size_t(n) || kv.back() != "key" +
+       std::to_string(n-1) + "=v,")
+    {
+        throw std::runtime_error{"failed test " + std::string(__FILE__) +
+                                 " in line " + std::to_string(lineNo)};
+    }
+    return bytes;
+}
+
+
+//-------------------------------------------------------------------
+/** @brief 4 times as many values must not cost much more than 4 times
+ *         as many heap bytes; copying the unmatched rest of the argument
+ *         in every step would cost 16 times as many */
+template<class CLI>
+void test(int lineNo, const CLI& cli, std::vector<std::string>& kv)
+{
+    const auto small = bytes_allocated(lineNo, cli, kv, 2000);
+    const auto large = bytes_allocated(lineNo, cli, kv, 8000);
+    if(large > 6 * small) {
+        throw std::runtime_error{"failed test " + std::string(__FILE__) +
+                                 " in line " + std::to_string(lineNo) +
+                                 ": cost is not linear"};
+    }
+}
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    using namespace clipp;
+    try {
+        std::vector<std::string> kv;
+
+        test(__LINE__, (option("-X") & values(up_to_comma{}, "kv", kv)), kv);
+
+        test(__LINE__, joinable(option("-X"), values(up_to_comma{}, "kv", kv)), kv);
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
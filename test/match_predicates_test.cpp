@@ -0,0 +1,125 @@
+/*****************************************************************************
+ *
+ * CLIPP - command line interfaces for modern C++
+ *
+ * released under MIT license
+ *
+ * (c) 2017-2018 André Müller; foss@andremueller-online.de
+ *
+ * Tests: value filters from namespace 'match'
+ *
+ *****************************************************************************/
+
+#include "testing.h"
+
+
+//-------------------------------------------------------------------
+struct active {
+    active() = default;
+    active(const std::string& mode_, const std::string& level_,
+           std::initializer_list<std::string> files_, bool x_ = false)
+    :
+        mode{mode_}, level{level_}, files{files_}, x{x_}
+    {}
+
+    std::string mode, level;
+    std::vector<std::string> files;
+    bool x = false;
+
+    friend bool operator == (const active& a, const active& b) noexcept {
+        return a.mode == b.mode && a.level == b.level &&
+               a.files == b.files && a.x == b.x;
+    }
+};
+
+
+//-------------------------------------------------------------------
+void test(int lineNo,
+          const std::initializer_list<const char*> args,
+          const active& matches)
+{
+    using namespace clipp;
+
+    active m;
+    const auto isLevel = [](const arg_string& s) {
+        return s.size() == 2 && s[0] == 'L' && std::isdigit(s[1]);
+    };
+
+    auto cli = (
+        option("-m") & value(match::one_of_values("fast","slow"), "mode", m.mode),
+        option("-x").set(m.x),
+        opt_value(isLevel, "level", m.level),
+        values(match::none_of("--", "-x", "-m"), "files", m.files)
+    );
+
+    run_wrapped_variants({ __FILE__, lineNo }, args, cli,
+              [&]{ m = active{}; },
+              [&]{ return m == matches; });
+}
+
+
+//-------------------------------------------------------------------
+void check(int lineNo, bool ok)
+{
+    if(!ok) {
+        throw std::runtime_error{"failed test " + std::string(__FILE__) +
+                                 " in line " + std::to_string(lineNo)};
+    }
+}
+
+void test_predicates()
+{
+    using namespace clipp;
+
+    const auto modes = match::one_of_values(arg_list{"a", "bb", ""});
+    check(__LINE__, modes("a") && modes("bb") && modes(""));
+    check(__LINE__, !modes("b") && !modes("aa") && !modes("A"));
+
+    const auto others = match::none_of(arg_list{"a", "bb"});
+    check(__LINE__, !others("a") && !others("bb") && others("b"));
+
+    check(__LINE__, match::prefix("--")("--x") && match::prefix("--")("--"));
+    check(__LINE__, !match::prefix("--")("-") && !match::prefix("--")("x--"));
+    check(__LINE__, match::prefix("")("") && !match::prefix_not("")("x"));
+    check(__LINE__, match::prefix_not("-")("x-") && !match::prefix_not("-")("-x"));
+
+    //positions are relative to the first non-whitespace character
+    const auto n = match::numbers{}("  x12.5e3y ");
+    check(__LINE__, n && n.at() == 1 && n.length() == 6);
+    const auto i = match::integers{}(" 12,345 ");
+    check(__LINE__, i && i.at() == 0 && i.length() == 2);
+    const auto k = match::integers{','}(" 12,345 ");
+    check(__LINE__, k && k.at() == 0 && k.length() == 6);
+    check(__LINE__, !match::numbers{}("   ") && !match::integers{}(""));
+
+    //custom match operations are accessible as 'match_function'
+    const auto intParam = integer("n");
+    const match_function& num = intParam.matcher();
+    check(__LINE__, num("12").length() == 2 && !num("x"));
+    const auto lenParam = value(
+        [](const arg_string& a) { return a.size() == 2; }, "l");
+    const match_function& len2 = lenParam.matcher();
+    check(__LINE__, len2("ab") && !len2("abc"));
+    check(__LINE__, !option("-a").matcher()("-a"));
+}
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        test(__LINE__, {}, active{});
+        test(__LINE__, {"-m", "fast"}, active{"fast", "", {}});
+        test(__LINE__, {"-m", "slow", "f1"}, active{"slow", "", {"f1"}});
+        test(__LINE__, {"-m", "medium"}, active{"", "", {"medium"}});
+        test(__LINE__, {"L2", "f1", "f2"}, active{"", "L2", {"f1", "f2"}});
+        test(__LINE__, {"-x", "L23"}, active{"", "", {"L23"}, true});
+        test(__LINE__, {"--", "f1"}, active{"", "", {"f1"}});
+
+        test_predicates();
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
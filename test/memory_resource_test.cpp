@@ -0,0 +1,175 @@
+/*****************************************************************************
+ *
+ * CLIPP - command line interfaces for modern C++
+ *
+ * released under MIT license
+ *
+ * (c) 2017-2018 André Müller; foss@andremueller-online.de
+ *
+ * Tests: parser state and parsing results allocated from a
+ *        user-provided memory resource (requires C++17 and
+ *        CLIPP_ENABLE_PMR)
+ *
+ *****************************************************************************/
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#  if __has_include(<memory_resource>)
+#    define CLIPP_ENABLE_PMR
+#  endif
+#endif
+
+#include "testing.h"
+
+
+#ifdef CLIPP_HAS_PMR
+
+//-------------------------------------------------------------------
+/** @brief counts allocations and forwards them to the global heap */
+class counting_resource : public std::pmr::memory_resource {
+public:
+    std::size_t allocs = 0;
+
+private:
+    void* do_allocate(std::size_t n, std::size_t align) override {
+        ++allocs;
+        return std::pmr::new_delete_resource()->allocate(n, align);
+    }
+    void do_deallocate(void* p, std::size_t n, std::size_t align) override {
+        std::pmr::new_delete_resource()->deallocate(p, n, align);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& o) const noexcept override {
+        return this == &o;
+    }
+};
+
+
+//-------------------------------------------------------------------
+/** @brief replaces the default memory resource while in scope */
+class default_resource {
+public:
+    explicit
+    default_resource(std::pmr::memory_resource* res):
+        old_{std::pmr::set_default_resource(res)}
+    {}
+    ~default_resource() { std::pmr::set_default_resource(old_); }
+
+    default_resource(const default_resource&) = delete;
+    default_resource& operator = (const default_resource&) = delete;
+
+private:
+    std::pmr::memory_resource* old_;
+};
+
+
+//-------------------------------------------------------------------
+/** @brief compiled interface that is parsed using memory resource 'res' */
+struct arena_cli {
+    const clipp::compiled_cli& cli;
+    std::pmr::memory_resource* res;
+};
+
+clipp::parsing_result
+parse(const std::initializer_list<const char*>& args, const arena_cli& a)
+{
+    return clipp::parse(clipp::arg_list(args.begin(), args.end()),
+                        a.cli, a.res);
+}
+
+
+//-------------------------------------------------------------------
+struct active {
+    active() = default;
+    explicit
+    active(std::string db_, std::vector<std::string> keys_,
+           std::vector<std::string> vals_, int missing_)
+    :
+        db{std::move(db_)}, keys{std::move(keys_)}, vals{std::move(vals_)},
+        missing{missing_}
+    {}
+
+    std::string db;
+    std::vector<std::string> keys, vals;
+    int missing = 0;
+
+    friend bool operator == (const active& x, const active& y) noexcept {
+        return x.db == y.db && x.keys == y.keys && x.vals == y.vals &&
+               x.missing == y.missing;
+    }
+};
+
+
+//-------------------------------------------------------------------
+void test(int lineNo,
+          const std::initializer_list<const char*> args,
+          const active& matches)
+{
+    using namespace clipp;
+
+    active m;
+
+    //repeated groups & required parameters: the parser has to keep
+    //track of mappings, alternatives and missing parameters
+    auto cli = (
+        command("put"),
+        required("--db").if_missing([&]{ ++m.missing; }) & value("db", m.db),
+        repeatable(
+            option("-k") & value("key", m.keys) & value("val", m.vals)
+        )
+    );
+
+    counting_resource counter;
+
+    //parser state of 'parse' calls is allocated from default resource
+    {
+        std::pmr::monotonic_buffer_resource arena{&counter};
+        default_resource scope{&arena};
+
+        run_wrapped_variants({ __FILE__, lineNo }, args, cli,
+                  [&]{ m = active{}; },
+                  [&]{ return m == matches && counter.allocs > 0; });
+    }
+
+    //explicitly passed resource; any allocation from the default
+    //resource would throw
+    counter.allocs = 0;
+    {
+        const compiled_cli compiled{cli};
+        std::pmr::monotonic_buffer_resource arena{&counter};
+        default_resource scope{std::pmr::null_memory_resource()};
+
+        m = active{};
+        run_test({ __FILE__, lineNo }, args, arena_cli{compiled, &arena},
+                 [&]{ return m == matches && counter.allocs > 0; });
+    }
+}
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        test(__LINE__, {}, active{"", {}, {}, 1});
+        test(__LINE__, {"put", "--db", "x"}, active{"x", {}, {}, 0});
+        test(__LINE__, {"put", "-k", "a", "1"}, active{"", {"a"}, {"1"}, 1});
+
+        test(__LINE__, {"put", "--db", "x", "-k", "a", "1", "-k", "b", "2"},
+                       active{"x", {"a","b"}, {"1","2"}, 0});
+
+        test(__LINE__, {"put", "-k", "a", "1", "--db", "x", "-k", "b", "2"},
+                       active{"x", {"a","b"}, {"1","2"}, 0});
+
+        const std::string key (100, 'k');
+        test(__LINE__, {"put", "--db", "x", "-k", key.c_str(), "1"},
+                       active{"x", {key}, {"1"}, 0});
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
+
+#else
+
+int main() {}
+
+#endif
@@ -0,0 +1,150 @@
+/*****************************************************************************
+ *
+ * CLIPP - command line interfaces for modern C++
+ *
+ * released under MIT license
+ *
+ * (c) 2017-2018 André Müller; foss@andremueller-online.de
+ *
+ * Tests: parsing many command lines with one (reset) parser must yield
+ *        the same results as parsing each of them with a new parser
+ *
+ *****************************************************************************/
+
+#include "testing.h"
+
+
+//-------------------------------------------------------------------
+/** @brief all actions of one parse call in order of execution */
+using events = std::vector<std::string>;
+
+
+//-------------------------------------------------------------------
+/** @brief parser that is reset & reused for each parse call */
+struct reused {
+    clipp::parser& p;
+};
+
+clipp::parsing_result
+parse(const std::initializer_list<const char*>& args, const reused& r)
+{
+    return clipp::parse(clipp::arg_list(args.begin(), args.end()), r.p);
+}
+
+
+//-------------------------------------------------------------------
+/**
+ * @brief repeats, conflicts, blocked and missing parameters depend on
+ *        the parser's state; none of it must leak into the next
+ *        command line
+ */
+class fixture {
+public:
+    fixture():
+        cli_{make_cli()}, compiled_{cli_}, parser_{compiled_}
+    {}
+
+    void test(int lineNo,
+              const std::initializer_list<const char*> args,
+              const events& expected)
+    {
+        //new parser for each parse call
+        log_.clear();
+        run_test({ __FILE__, lineNo }, args, cli_,
+                 [&]{ return log_ == expected; });
+
+        //reused parser
+        log_.clear();
+        run_test({ __FILE__, lineNo }, args, reused{parser_},
+                 [&]{ return log_ == expected; });
+    }
+
+private:
+    clipp::group make_cli()
+    {
+        using namespace clipp;
+
+        const auto log = [this](const char* what) {
+            return [this,what](int idx) {
+                log_.push_back(what + std::to_string(idx));
+            };
+        };
+        const auto arg = [this](const char* s) { log_.push_back(s); };
+
+        return (
+            command("run").if_missing(log("missing run @")),
+            option("-a").call(arg).if_repeated(log("repeated -a @")),
+            (option("-k").call(arg).if_conflicted(log("conflict -k @")) |
+             option("-l").call(arg).if_conflicted(log("conflict -l @"))),
+            repeatable( command("x").call(arg).if_blocked(log("blocked x @")) &
+                        integer("n").call(arg).if_blocked(log("blocked n @")) )
+        );
+    }
+
+    events log_;
+    clipp::group cli_;
+    clipp::compiled_cli compiled_;
+    clipp::parser parser_;
+};
+
+
+//-------------------------------------------------------------------
+/** @brief the buffer of arg mappings must stay with a reused parser */
+void test_capacity(int lineNo)
+{
+    using namespace clipp;
+
+    std::vector<std::string> files;
+    auto cli = ( command("run"), values("file", files) );
+    const auto args = arg_list{"run", "a", "b", "c", "d", "e", "f"};
+
+    parser p{cli};
+    const auto res1 = parse(args, p);
+    const auto cap = p.args().capacity();
+    const auto buf = p.args().data();
+
+    const auto res2 = parse(args, p);
+
+    const auto n = std::ptrdiff_t(args.size());
+
+    if(std::distance(res1.begin(), res1.end()) != n ||
+       std::distance(res2.begin(), res2.end()) != n ||
+       files.size() != 2 * (args.size() - 1) ||
+       cap < args.size() || p.args().capacity() != cap ||
+       p.args().data() != buf)
+    {
+        throw std::runtime_error{"failed test " + std::string(__FILE__) +
+                                 " in line " + std::to_string(lineNo)};
+    }
+}
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        test_capacity(__LINE__);
+
+        fixture f;
+
+        f.test(__LINE__, {}, {"missing run @-1"});
+        f.test(__LINE__, {"run", "-a"}, {"-a"});
+        f.test(__LINE__, {"run", "-a", "-a"}, {"-a", "repeated -a @2"});
+        f.test(__LINE__, {"run", "-a"}, {"-a"});
+
+        f.test(__LINE__, {"run", "-k", "-l"},
+                         {"conflict -k @1", "conflict -l @2"});
+        f.test(__LINE__, {"run", "-l"}, {"-l"});
+        f.test(__LINE__, {"run", "-k"}, {"-k"});
+
+        f.test(__LINE__, {"run", "x", "1", "x", "2"}, {"x", "1", "x", "2"});
+        f.test(__LINE__, {"x", "1"},
+                         {"blocked x @0", "blocked n @1", "missing run @-1"});
+        f.test(__LINE__, {"run", "x", "3"}, {"x", "3"});
+        f.test(__LINE__, {}, {"missing run @-1"});
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,121 @@
+/*****************************************************************************
+ *
+ * CLIPP - command line interfaces for modern C++
+ *
+ * released under MIT license
+ *
+ * (c) 2017-2018 André Müller; foss@andremueller-online.de
+ *
+ *****************************************************************************/
+
+#include "testing.h"
+
+#include <cstdlib>
+#include <new>
+
+
+//-------------------------------------------------------------------
+// counts heap bytes allocated by the parser
+//-------------------------------------------------------------------
+static std::size_t allocated = 0;
+
+void* operator new(std::size_t n)
+{
+    allocated += n;
+    if(auto p = std::malloc(n)) return p;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+#if __cplusplus >= 201402L
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+#endif
+
+
+//-------------------------------------------------------------------
+/** @brief 'n' repeats of the options of a flat CLI
+ *         in which every other option takes a value */
+clipp::arg_list repeats(int width, int n)
+{
+    clipp::arg_list args;
+    for(int k = 0; k < n; ++k) {
+        for(int i = 0; i < width; ++i) {
+            //visit options in a shuffled order
+            const int j = (i * 7 + k) % width;
+            args.push_back("--opt" + std::to_string(j));
+            if(j % 2) args.push_back("val");
+        }
+    }
+    return args;
+}
+
+
+//-------------------------------------------------------------------
+/** @brief heap bytes allocated by parsing 'n' repeats */
+template<class CLI>
+std::size_t
+bytes_allocated(int lineNo, const CLI& cli, int width, int n, int& count)
+{
+    const auto args = repeats(width, n);
+    count = 0;
+
+    allocated = 0;
+    const bool ok = bool(clipp::parse(args, cli));
+    const auto bytes = allocated;
+
+    if(!ok || count != width * n) {
+        throw std::runtime_error{"failed test " + std::string(__FILE__) +
+                                 " in line " + std::to_string(lineNo)};
+    }
+    return bytes;
+}
+
+
+//-------------------------------------------------------------------
+/** @brief re-entering repeat groups must not grow the parser's scope
+ *         stack, so 4 times as many repeats must not cost much more than
+ *         4 times as many heap bytes */
+template<class CLI>
+void test(int lineNo, const CLI& cli, int width, int& count)
+{
+    const auto small = bytes_allocated(lineNo, cli, width, 100, count);
+    const auto large = bytes_allocated(lineNo, cli, width, 400, count);
+    if(large > 6 * small) {
+        throw std::runtime_error{"failed test " + std::string(__FILE__) +
+                                 " in line " + std::to_string(lineNo) +
+                                 ": cost is not linear"};
+    }
+}
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    using namespace clipp;
+    try {
+        const int width = 20;
+        int count = 0;
+        std::string v;
+
+        group cli;
+        for(int i = 0; i < width; ++i) {
+            const auto flag = "--opt" + std::to_string(i);
+            if(i % 2) {
+                cli.push_back(repeatable(option(flag).call([&]{ ++count; })
+                                         & value("v", v)));
+            } else {
+                cli.push_back(option(flag).call([&]{ ++count; })
+                              .repeatable(true));
+            }
+        }
+
+        test(__LINE__, cli, width, count);
+
+        test(__LINE__, group{option("-x"), cli}, width, count);
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,106 @@
+/*****************************************************************************
+ *
+ * CLIPP - command line interfaces for modern C++
+ *
+ * released under MIT license
+ *
+ * (c) 2017-2018 André Müller; foss@andremueller-online.de
+ *
+ * Tests: arguments "@file" are replaced by the arguments in response files
+ *
+ *****************************************************************************/
+
+#include "testing.h"
+
+#include <fstream>
+#include <cstdio>
+
+
+//-------------------------------------------------------------------
+struct active {
+    bool v = false;
+    std::string out;
+    std::vector<std::string> files;
+
+    friend bool operator == (const active& a, const active& b) noexcept {
+        return a.v == b.v && a.out == b.out && a.files == b.files;
+    }
+};
+
+
+//-------------------------------------------------------------------
+void write_file(const std::string& name, const std::string& content)
+{
+    std::ofstream os{name};
+    os << content;
+}
+
+
+//-------------------------------------------------------------------
+void test(int lineNo,
+          const std::initializer_list<const char*> args,
+          const clipp::arg_list& expanded)
+{
+    using namespace clipp;
+
+    active m;
+    auto cli = (
+        command("cc"),
+        option("-v").set(m.v),
+        option("-o") & value("out", m.out),
+        values("files", m.files)
+    );
+
+    const auto res = parse(expanded, cli);
+    const auto expected = m;
+
+    m = active{};
+    const bool ok = stream_parse_expanded(args.begin(), args.end(), cli);
+
+    if(ok != bool(res) || !(m == expected)) {
+        throw std::runtime_error{"failed test " + std::string(__FILE__) +
+                                 " in line " + std::to_string(lineNo)};
+    }
+}
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    const std::string f1 = "clipp_response_test1.rsp";
+    const std::string f2 = "clipp_response_test2.rsp";
+    const std::string f3 = "clipp_response_test3.rsp";
+
+    write_file(f1, "-o out a.c\n  b.c\t\"c d.c\" 'e\"f.c' g\\ h.c '' @" + f2);
+    write_file(f2, "-v\r\nx\\\\y.c");
+    write_file(f3, "@" + f3);
+
+    try {
+        test(__LINE__, {"cc", "@clipp_response_test2.rsp"},
+                       {"cc", "-v", "x\\y.c"});
+
+        test(__LINE__, {"cc", "@clipp_response_test1.rsp", "z.c"},
+                       {"cc", "-o", "out", "a.c", "b.c", "c d.c", "e\"f.c",
+                        "g h.c", "", "-v", "x\\y.c", "z.c"});
+
+        //missing file => argument is kept
+        test(__LINE__, {"cc", "@clipp_response_test0.rsp", "-v"},
+                       {"cc", "@clipp_response_test0.rsp", "-v"});
+
+        //self-inclusion stops at maximum nesting depth
+        test(__LINE__, {"cc", "@clipp_response_test3.rsp"},
+                       {"cc", "@clipp_response_test3.rsp"});
+
+        test(__LINE__, {"cc", "@"}, {"cc", "@"});
+    }
+    catch(std::exception& e) {
+        std::remove(f1.c_str());
+        std::remove(f2.c_str());
+        std::remove(f3.c_str());
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    std::remove(f1.c_str());
+    std::remove(f2.c_str());
+    std::remove(f3.c_str());
+}
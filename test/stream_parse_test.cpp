@@ -0,0 +1,212 @@
+/*****************************************************************************
+ *
+ * CLIPP - command line interfaces for modern C++
+ *
+ * released under MIT license
+ *
+ * (c) 2017-2018 André Müller; foss@andremueller-online.de
+ *
+ * Tests: parsing arguments one at a time with 'stream_parse' must report
+ *        the same mappings and execute the same actions as 'parse'
+ *
+ *****************************************************************************/
+
+#include "testing.h"
+
+
+//-------------------------------------------------------------------
+struct active {
+    bool a = false, b = false;
+    int n = 0;
+    double x = 0;
+    std::vector<std::string> files;
+    std::vector<int> conflicts;
+
+    friend bool operator == (const active& p, const active& q) noexcept {
+        return p.a == q.a && p.b == q.b && p.n == q.n && p.x == q.x &&
+               p.files == q.files && p.conflicts == q.conflicts;
+    }
+};
+
+
+//-------------------------------------------------------------------
+struct event {
+    clipp::arg_index index;
+    std::string arg;
+    const clipp::parameter* param;
+    std::size_t repeat;
+    bool blocked, conflict;
+};
+
+std::string summary(const std::vector<event>& events)
+{
+    std::string s;
+    for(const auto& e : events) {
+        s += std::to_string(e.index) + ":" + e.arg + "->" +
+             (e.param ? std::to_string(std::size_t(e.param)) : "-") +
+             " r" + std::to_string(e.repeat) +
+             (e.blocked ? " b" : "") + (e.conflict ? " c" : "") + "; ";
+    }
+    return s;
+}
+
+std::string summary(const clipp::parsing_result& res)
+{
+    std::vector<event> events;
+    for(const auto& m : res) {
+        events.push_back(event{m.index(), m.arg(), m.param(), m.repeat(),
+                               m.blocked(), m.conflict()});
+    }
+    auto s = summary(events);
+    for(const auto& m : res.missing()) {
+        s += "miss " + std::to_string(std::size_t(m.param())) + " after " +
+             std::to_string(m.after_index()) + "; ";
+    }
+    return s;
+}
+
+
+//-------------------------------------------------------------------
+void test(int lineNo, const clipp::arg_list& args)
+{
+    using namespace clipp;
+
+    active m;
+    const auto conflict = [&](int i){ m.conflicts.push_back(i); };
+    auto cli = (
+        command("run"),
+        joinable(option("-a").set(m.a), option("-b").set(m.b)),
+        repeatable( (command("x") & integer("n", m.n)) | command("y") ),
+        option("-o") & number("x", m.x),
+        option("-k").if_conflicted(conflict) |
+        option("-l").if_conflicted(conflict),
+        values("files", m.files)
+    );
+
+    const auto expected = parse(args, cli);
+    const auto expectedState = m;
+
+    m = active{};
+    std::vector<event> events;
+    std::string misses;
+    auto obs = parser::observer{}
+        .on_match([&](const parser::arg_mapping& a) {
+            events.push_back(event{a.index(), a.arg(), a.param(), a.repeat(),
+                                   a.blocked(), a.conflict()});
+        })
+        .on_late_conflict([&](const parameter& p, arg_index idx) {
+            for(auto& e : events) {
+                if(e.index == idx && e.param == &p) e.conflict = true;
+            }
+        })
+        .on_missing([&](const parameter& p, arg_index idx) {
+            misses += "miss " + std::to_string(std::size_t(&p)) + " after " +
+                      std::to_string(idx) + "; ";
+        });
+
+    const bool ok = stream_parse(args.begin(), args.end(), cli, obs);
+
+    if(ok != bool(expected) || summary(events) + misses != summary(expected) ||
+       !(m == expectedState))
+    {
+        throw std::runtime_error{"failed test " + std::string(__FILE__) +
+                                 " in line " + std::to_string(lineNo)};
+    }
+}
+
+
+//-------------------------------------------------------------------
+void test_memory(int lineNo)
+{
+    using namespace clipp;
+
+    std::size_t mapped = 0;
+    auto cli = ( command("run"), values("files").call([&]{ ++mapped; }) );
+    const compiled_cli compiled{cli};
+
+    std::size_t reported = 0;
+    auto obs = parser::observer{}
+        .on_match([&](const parser::arg_mapping&) { ++reported; });
+
+    parser p{compiled};
+    p.observe(&obs, false);
+    p("run");
+    for(int i = 0; i < 1000; ++i) {
+        p("file");
+        //mappings of previous arguments are not kept
+        if(p.args().size() != 1) {
+            throw std::runtime_error{"failed test " + std::string(__FILE__) +
+                                     " in line " + std::to_string(lineNo)};
+        }
+    }
+
+    arg_list args (1000, "file");
+    args.front() = "run";
+    const bool ok = stream_parse(args.begin(), args.end(), compiled);
+
+    if(reported != 1001 || !ok || mapped != 999) {
+        throw std::runtime_error{"failed test " + std::string(__FILE__) +
+                                 " in line " + std::to_string(lineNo)};
+    }
+}
+
+
+//-------------------------------------------------------------------
+void test_late_conflicts(int lineNo, int n)
+{
+    using namespace clipp;
+
+    auto cli = (command("a") & values("v")) | command("b");
+    const compiled_cli compiled{cli};
+
+    //late conflicts of all previously streamed arguments
+    std::vector<arg_index> late;
+    auto obs = parser::observer{}
+        .on_late_conflict([&](const parameter&, arg_index idx) {
+            late.push_back(idx);
+        });
+
+    parser p{compiled};
+    p.observe(&obs, false);
+    p("a");
+    for(int i = 0; i < n; ++i) p("v");
+    p("b");
+
+    bool ok = p.args().size() == 1 && p.args().front().conflict() &&
+              late.size() == std::size_t(n + 1);
+    for(std::size_t i = 0; ok && i < late.size(); ++i) {
+        ok = late[i] == arg_index(i);
+    }
+    if(!ok) {
+        throw std::runtime_error{"failed test " + std::string(__FILE__) +
+                                 " in line " + std::to_string(lineNo)};
+    }
+}
+
+
+//-------------------------------------------------------------------
+int main()
+{
+    try {
+        test(__LINE__, {});
+        test(__LINE__, {"run", "y", "f1"});
+        test(__LINE__, {"run", "-ab", "x", "12", "y", "f1", "f2"});
+        test(__LINE__, {"run", "x"});
+        test(__LINE__, {"y", "-a", "run"});
+        test(__LINE__, {"run", "-b", "x", "7", "y", "x", "8", "f", "-a"});
+        //later match conflicts with already processed argument
+        test(__LINE__, {"run", "-k", "f1", "-l", "f2"});
+        test(__LINE__, {"run", "-k", "-l", "-k"});
+        //argument corrected by its successor
+        test(__LINE__, {"run", "-o12", ".34", "f"});
+        test(__LINE__, {"run", "-o", "-1", ".5"});
+
+        test_memory(__LINE__);
+        test_late_conflicts(__LINE__, 0);
+        test_late_conflicts(__LINE__, 1000);
+    }
+    catch(std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
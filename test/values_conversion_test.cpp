@@ -103,6 +103,116 @@ void test_conv(int lineNo)
 }
 
 
+//-------------------------------------------------------------------
+template<class T>
+void test_vector(int lineNo, int n)
+{
+    using namespace clipp;
+
+    std::vector<T> xs;
+    std::vector<std::string> strs {"-n"};
+    for(int i = 0; i < n; ++i) strs.push_back(std::to_string(i));
+
+    std::vector<const char*> args;
+    for(const auto& s : strs) args.push_back(s.c_str());
+
+    auto cli = group( option("-n") & numbers("xs", xs) );
+    parse(args.begin(), args.end(), cli);
+
+    bool ok = xs.size() == std::size_t(n);
+    for(int i = 0; ok && i < n; ++i) ok = equals<T>::result(xs[i], T(i));
+    //space for all values is reserved up front
+    if(!ok || xs.capacity() != xs.size()) {
+        throw std::runtime_error{"failed test " + std::string(__FILE__) +
+                                 " in line " + std::to_string(lineNo)};
+    }
+}
+
+
+//-------------------------------------------------------------------
+/** values of many parse calls are appended to the same vector;
+ *  reserving must not defeat its geometric growth */
+void test_vector_growth(int lineNo, int parses, int n)
+{
+    using namespace clipp;
+
+    std::vector<int> xs;
+    std::vector<std::string> strs {"-n"};
+    for(int i = 0; i < n; ++i) strs.push_back(std::to_string(i));
+
+    std::vector<const char*> args;
+    for(const auto& s : strs) args.push_back(s.c_str());
+
+    auto cli = (option("-n") & numbers("xs", xs));
+    parser p{compile(cli)};
+
+    int reallocs = 0;
+    for(int k = 0; k < parses; ++k) {
+        const auto cap = xs.capacity();
+        if(k % 2) {
+            parse(args.begin(), args.end(), cli);
+        } else {
+            parse(arg_list(args.begin(), args.end()), p);
+        }
+        if(xs.capacity() != cap) ++reallocs;
+    }
+
+    bool ok = xs.size() == std::size_t(parses) * std::size_t(n);
+    for(std::size_t i = 0; ok && i < xs.size(); ++i) {
+        ok = xs[i] == int(i % std::size_t(n));
+    }
+    //capacity at least doubles with each reallocation
+    int maxReallocs = 1;
+    for(auto c = std::size_t(n); c < xs.size(); c *= 2) ++maxReallocs;
+
+    if(!ok || reallocs > maxReallocs) {
+        throw std::runtime_error{"failed test " + std::string(__FILE__) +
+                                 " in line " + std::to_string(lineNo)};
+    }
+}
+
+
+//-------------------------------------------------------------------
+/** number/integer parameters set their targets from the value that was
+ *  scanned during matching; results must not differ from converting
+ *  the argument string */
+template<class T>
+void test_scanned(int lineNo, const std::string& arg)
+{
+    using namespace clipp;
+
+    T x = T(0), y = T(0), expected = T(0);
+    std::vector<T> xs, ys;
+    parse({arg.c_str()}, group( value("", expected) ));
+    parse({arg.c_str()}, group( number("", x, xs) ));
+    parse({arg.c_str()}, group( integer("", y, ys) ));
+
+    const bool intArg = str::represents_integer(arg);
+    if(!equals<T>::result(x, expected) ||
+       xs.size() != 1 || !equals<T>::result(xs.front(), expected) ||
+       (intArg && (!equals<T>::result(y, expected) ||
+                   ys.size() != 1 || !equals<T>::result(ys.front(), expected))))
+    {
+        throw std::runtime_error{"failed test " + std::string(__FILE__) +
+                                 " in line " + std::to_string(lineNo)};
+    }
+}
+
+template<class T>
+void test_scanned(int lineNo)
+{
+    for(const char* arg : {"0", "-0", "+0", "7", "-7", "+42", "0042",
+        "255", "256", "-129", "65535", "65536", "2147483647", "2147483648",
+        "-2147483649", "4503599627370495", "4503599627370496",
+        "99999999999999999999", "1.5", "-2.25e2", "5.", "+.5", "1e5",
+        "1E-5", "3.14159265358979323846", "1e15", "1e16", "1e-16", "1e-17",
+        "0.000001", "123456.789e-3"})
+    {
+        test_scanned<T>(lineNo, arg);
+    }
+}
+
+
 //-------------------------------------------------------------------
 template<class T, class Wide, bool = (sizeof(Wide) > sizeof(T))>
 struct test_clamp {
@@ -154,6 +264,27 @@ int main()
         test_conv<double>( __LINE__ );
         test_conv<long double>( __LINE__ );
 
+        test<double>(__LINE__, 0, "1.5", 1.5);
+        test<double>(__LINE__, 0, "  -2.25e2  ", -225.0);
+        test<double>(__LINE__, 0, ".5", 0.5);
+        test<double>(__LINE__, 0, "5.", 5.0);
+        test<double>(__LINE__, 0, "1e", 1.0);
+        test<double>(__LINE__, 0, "12abc", 12.0);
+        test<double>(__LINE__, 0, "0x10", 16.0);
+        test<double>(__LINE__, 0, "1e400", std::numeric_limits<double>::infinity());
+        test<double>(__LINE__, 0, "-inf", -std::numeric_limits<double>::infinity());
+        test<double>(__LINE__, 0, "3.14159265358979323846264338327950288", 3.14159265358979);
+        test<double>(__LINE__, 0, "0.000000000000000000000000000001e30", 1.0);
+        test<float>(__LINE__, 0, "2.5e-1", 0.25f);
+        test<long double>(__LINE__, 0, "123456789012345678e-10", 12345678.9012345678L);
+
+        test<int>(__LINE__, 0, "+7", 7);
+        test<int>(__LINE__, 0, "12abc", 12);
+        test<int>(__LINE__, 0, "abc", 0);
+        test<int>(__LINE__, 0, "99999999999999999999999", std::numeric_limits<int>::max());
+        test<long long int>(__LINE__, 0, "-99999999999999999999999", std::numeric_limits<long long int>::lowest());
+        test<unsigned int>(__LINE__, 0, "99999999999999999999999", std::numeric_limits<unsigned int>::max());
+
         test<char>(__LINE__, 0, "",  0);
         test<char>(__LINE__, 0, " ", ' ');
         test<char>(__LINE__, 0, "0", '0');
@@ -167,6 +298,24 @@ int main()
         test<char>(__LINE__, 0, "-128", -128);
         test<char>(__LINE__, 0, "-129", -128);
 
+        test_scanned<unsigned char>(__LINE__);
+        test_scanned<short int>(__LINE__);
+        test_scanned<unsigned int>(__LINE__);
+        test_scanned<int>(__LINE__);
+        test_scanned<long long int>(__LINE__);
+        test_scanned<unsigned long long int>(__LINE__);
+        test_scanned<float>(__LINE__);
+        test_scanned<double>(__LINE__);
+        test_scanned<long double>(__LINE__);
+
+        test_vector<int>(__LINE__, 50);
+        test_vector<unsigned long int>(__LINE__, 100);
+        test_vector<double>(__LINE__, 75);
+
+        test_vector_growth(__LINE__, 1000, 1);
+        test_vector_growth(__LINE__, 1000, 10);
+        test_vector_growth(__LINE__, 200, 33);
+
         test<std::string>(__LINE__, "", "",  "");
         test<std::string>(__LINE__, "", " ", " ");
         test<std::string>(__LINE__, "", "0", "0");